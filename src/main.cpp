@@ -1,10 +1,24 @@
 #include <raylib.h> // game header
 #include "raymath.h" // controlling vectors
+#include "rlgl.h" // batched particle quads
 #include <string> // for frame names
 #include <cmath> // for fmin
 #include <vector>
 #include <algorithm>
 #include <bits/stdc++.h>
+#include <thread> // job system workers
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <chrono> // simulation tick timing
+#include <cassert>
+#if defined(__linux__) && !defined(PLATFORM_WEB)
+#define MAP_WATCH_INOTIFY // the map's folder is watched through the kernel instead of polled
+#include <sys/inotify.h> // map hot reload
+#include <unistd.h>
+#endif
 
 #define RAYTMX_IMPLEMENTATION
 #include "raytmx.h"
@@ -17,8 +31,244 @@ enum class GameState {
 };
 
 // comment
+const char* mapFile = "assets/Tilemap/WAVESPAWN.tmx";
+const char* mapDirectory = "assets/Tilemap"; // the map's tilesets and images, watched for hot reload
 TmxMap* currentMap = nullptr;
 TmxLayer* wallLayer = nullptr;
+TmxAsyncLoad* mapLoad = nullptr; // map still loading in the background
+TmxAsyncLoad* mapReload = nullptr; // new version of the map loading in the background after its files were saved
+TmxMap* reloadedMap = nullptr; // loaded, waiting for a frame where the simulation isn't holding the map
+std::atomic<bool> mapReady{false}; // set by the main thread once currentMap can be used by the simulation
+std::mutex mapMutex; // held by a simulation tick, so the map it reads isn't swapped out from under it
+
+// Whether there's a wall layer with tiles, either as one array (finite maps) or as chunks (infinite maps)
+bool HasWallLayer() {
+    return wallLayer && wallLayer->type == LAYER_TYPE_TILE_LAYER &&
+           (wallLayer->exact.tileLayer.tiles || wallLayer->exact.tileLayer.chunks);
+}
+
+// Wall tile GID at a tile position, whether or not its chunk is resident
+unsigned int WallTileAt(int tileX, int tileY) {
+    return GetTMXTileLayerGid(currentMap, &wallLayer->exact.tileLayer, tileX, tileY);
+}
+
+// Whether a wall tile overlaps a rectangle. The last pixel row and column are its far edges, so touching isn't overlap
+bool IsWallInRect(Rectangle rect) {
+    int left_tile = (int)floorf(rect.x / currentMap->tileWidth);
+    int right_tile = (int)floorf((rect.x + rect.width - 1) / currentMap->tileWidth);
+    int top_tile = (int)floorf(rect.y / currentMap->tileHeight);
+    int bottom_tile = (int)floorf((rect.y + rect.height - 1) / currentMap->tileHeight);
+
+    // Finite maps (all the shipped arenas) keep checking the edge tiles for anything past the map's edge
+    if (!currentMap->isInfinite) {
+        left_tile = std::max(0, std::min(left_tile, (int)currentMap->width - 1));
+        right_tile = std::max(0, std::min(right_tile, (int)currentMap->width - 1));
+        top_tile = std::max(0, std::min(top_tile, (int)currentMap->height - 1));
+        bottom_tile = std::max(0, std::min(bottom_tile, (int)currentMap->height - 1));
+    }
+
+    for (int y = top_tile; y <= bottom_tile; y++) {
+        for (int x = left_tile; x <= right_tile; x++) {
+            if (WallTileAt(x, y) != 0) return true;
+        }
+    }
+    return false;
+}
+
+// Whether a point is inside a wall tile or off a finite map. Always false without a wall layer
+bool IsWallAt(Vector2 p) {
+    if (!HasWallLayer()) return false;
+    int tileX = (int)floorf(p.x / currentMap->tileWidth);
+    int tileY = (int)floorf(p.y / currentMap->tileHeight);
+    if (!currentMap->isInfinite &&
+        (tileX < 0 || tileY < 0 || tileX >= (int)currentMap->width || tileY >= (int)currentMap->height)) return true;
+    return WallTileAt(tileX, tileY) != 0;
+}
+
+// Input the main thread samples for the simulation thread
+struct InputState {
+    bool right = false, left = false, up = false, down = false; // held
+    bool dashPressed = false, hitPressed = false, attackPressed = false, shootPressed = false, startPressed = false,
+         clickPressed = false; // pressed since the last simulation tick
+    Vector2 mouse = {0, 0}; // on the 320x180 canvas
+};
+
+InputState input; // what the simulation sees this tick
+InputState pendingInput; // collected by the main thread until the next tick
+std::mutex inputMutex; // guards pendingInput
+float frameDt = 1.0f / 60.0f; // simulation step in seconds
+
+#ifndef NDEBUG
+// Debug builds count heap allocations made through operator new by every thread, the job workers included, so hot
+// loops can check they don't allocate. malloc() and raylib's MemAlloc() (raytmx, file loading, audio) aren't counted
+std::atomic<size_t> allocationCount{0};
+thread_local bool allocationsAllowed = false; // set by AllowAllocations, for work that's expected to allocate
+
+void* operator new(size_t size) {
+    if (!allocationsAllowed) allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// Asserts when anything was allocated, on any thread, while the scope it lives in ran. Counting every thread means
+// an allocation on another thread can fail a check here, so work that allocates on purpose (loading files, setting
+// up a new map) goes in an AllowAllocations scope instead
+struct NoAllocations {
+    size_t start = allocationCount.load();
+    ~NoAllocations() { assert(allocationCount.load() == start && "allocated in a loop that must not"); }
+};
+
+// Keeps this thread's allocations out of the count until the scope ends
+struct AllowAllocations {
+    bool wasAllowed = allocationsAllowed;
+    AllowAllocations() { allocationsAllowed = true; }
+    ~AllowAllocations() { allocationsAllowed = wasAllowed; }
+};
+#else
+struct NoAllocations { ~NoAllocations() {} };
+struct AllowAllocations { ~AllowAllocations() {} };
+#endif
+
+// Fixed number of slots that never move. Spawn() takes a slot off the free list and Release() gives it back,
+// so slashes and other projectiles never allocate once the game is running
+template <typename T, int Capacity>
+class SlotPool {
+public:
+    SlotPool() { Clear(); }
+
+    // Constructs a T in a free slot, nullptr when every slot is in use
+    template <typename... Args>
+    T* Spawn(Args&&... args) {
+        if (freeHead < 0) return nullptr;
+        int slot = freeHead;
+        freeHead = nextFree[slot];
+        items[slot] = T(std::forward<Args>(args)...);
+        active[slot] = true;
+        count++;
+        return &items[slot];
+    }
+
+    void Release(int slot) {
+        if (!active[slot]) return;
+        active[slot] = false;
+        nextFree[slot] = freeHead;
+        freeHead = slot;
+        count--;
+    }
+
+    void Clear() {
+        for (int i = 0; i < Capacity; i++) {
+            active[i] = false;
+            nextFree[i] = i + 1 < Capacity ? i + 1 : -1;
+        }
+        freeHead = 0;
+        count = 0;
+    }
+
+    // Calls fn on every slot in use, in slot order
+    template <typename F>
+    void ForEach(F fn) {
+        for (int i = 0; i < Capacity; i++) {
+            if (active[i]) fn(items[i]);
+        }
+    }
+
+    // Releases every slot in use that pred returns true for
+    template <typename F>
+    void ReleaseIf(F pred) {
+        for (int i = 0; i < Capacity; i++) {
+            if (active[i] && pred(items[i])) Release(i);
+        }
+    }
+
+    int Count() const { return count; }
+
+private:
+    T items[Capacity];
+    bool active[Capacity];
+    int nextFree[Capacity]; // free list through the unused slots, -1 ends it
+    int freeHead;
+    int count;
+};
+
+// Fixed-capacity queue over a circular array that can be taken from either end. PushBack() returns false when
+// it's full instead of growing, so queues that fill and drain every tick never allocate
+template <typename T, int Capacity>
+class RingBuffer {
+public:
+    bool PushBack(const T& item) {
+        if (count == Capacity) return false;
+        items[(head + count) % Capacity] = item;
+        count++;
+        return true;
+    }
+
+    T& Front() { return items[head]; }
+    T& Back() { return items[(head + count - 1) % Capacity]; }
+    void PopFront() {
+        head = (head + 1) % Capacity;
+        count--;
+    }
+    void PopBack() { count--; }
+    void Clear() { head = count = 0; }
+    bool Empty() const { return count == 0; }
+    int Count() const { return count; }
+
+private:
+    T items[Capacity];
+    int head = 0; // index of the front item
+    int count = 0;
+};
+
+// Short-lived sparks for hits, deaths, dashes and wave changes. Stored as a struct of arrays and updated in
+// flat loops the compiler can vectorize; dead particles are swap-removed, and Draw() is one batch of quads
+class ParticleSystem {
+public:
+    static const int capacity = 8192;
+
+    ParticleSystem();
+    // Spawns up to count particles flying out of pos in random directions, speed in pixels per second
+    void Burst(Vector2 pos, int count, Color color, float speed, float lifetime, float size);
+    void Update(float dt);
+    void Draw();
+    void Clear();
+    int Count() const { return (int)x.size(); }
+
+private:
+    void Remove(int i);
+    float Random(); // 0 to 1
+
+    std::vector<float> x, y;
+    std::vector<float> velX, velY;
+    std::vector<float> life;
+    std::vector<float> invLifetime; // 1 / starting life, for the fade
+    std::vector<float> alpha;
+    std::vector<float> size;
+    std::vector<Color> color;
+    uint32_t seed = 0x9e3779b9;
+};
+
+ParticleSystem particles;
+
+// Startup texture loading. Images are decoded across the job system's threads, then uploaded in one pass on the main
+// thread, which owns the GPU context. Textures stay empty (id 0) until UploadAll(), and ones that fail stay empty
+class TexturePreloader {
+public:
+    void Add(Texture2D* texture, const std::string& path);
+    void DecodeAll(); // before the simulation thread starts, since this uses its job queue
+    void UploadAll();
+
+private:
+    struct Entry {
+        Texture2D* texture;
+        std::string path;
+        Image image;
+    };
+    std::vector<Entry> entries;
+};
 
 class Slash {
 public:
@@ -28,10 +278,14 @@ public:
     int frame;
     float animTimer;
     bool finished;
+    static const int maxHits = 64;
+    uint32_t hitIds[maxHits]; // sorted ids of the enemies this swing has hit
+    int hitCount;
 
-    static void LoadAssets();
+    static void LoadAssets(TexturePreloader& preloader);
     static void UnloadAssets();
 
+    Slash() = default; // empty pool slot
     Slash(Vector2 playerPos, Vector2 dir);
 
     void Update(float dt);
@@ -39,11 +293,14 @@ public:
     void Draw();
 
     Rectangle GetHitbox();
+    bool TryHit(uint32_t enemyId); // records the hit, false if this swing already hit that enemy
 };
 
 Texture2D Slash::frames[3]; // definition
 
-std::vector<Slash> slashes;
+// A slash lasts 0.3s and there's at most one per tick, so this is never full
+typedef SlotPool<Slash, 32> SlashPool;
+SlashPool slashes;
 
 enum class PlayerState {
     Idle,
@@ -66,6 +323,8 @@ public:
     float dashDuration = 0.2f; // dash duration in seconds
     float dashCooldownDuration = 1.0f; // dash cooldown in seconds
     float dashSpeed = 10.0f; // dash speed (5x normal speed of 2)
+    float shootCooldown = 0.0f; // cooldown timer for throwing a bolt
+    float shootCooldownDuration = 0.4f; // seconds between bolts
 
     PlayerState state = PlayerState::Idle; // default
 
@@ -82,7 +341,7 @@ public:
     float hitTimer = 0.0f; 
     float hitDuration = 0.2f; // seconds
 
-    void Load();
+    void Load(TexturePreloader& preloader);
     void Unload();
     void Update();
     void Draw();
@@ -125,21 +384,38 @@ protected:
     Vector2 knockbackVelocity;  // Knockback applied when hit
     float knockbackTimer;       // Duration for knockback
     EnemyType type;             // To identify enemy type for pooling
+    bool knockedBack;           // Whether the last update was knockback (which skips separation)
+    uint32_t id;                // Unique per spawn, so pooled enemies that get reused aren't mistaken for old ones
+    float fireTimer;            // Time until a ranged enemy can shoot again
+    bool wantsToFire;           // Set by Update(), the shot is spawned afterwards in order
+    float pendingTime;          // Time since this enemy last updated, off-screen enemies wait for their turn
+    bool scheduled;             // Whether it updates this tick
 
 public:
-    Enemy(Vector2 pos, EnemyType t, Texture2D* frames, int baseHp, int baseDmg, float spd, float range);
+    Enemy(Vector2 pos, EnemyType t, Texture2D* frames);
     virtual ~Enemy();
 
-    virtual void Update(float dt, const Player& player);
+    virtual void Update(float dt, const Player& player); // only touches this enemy, so it can run on any thread
+    void Separate(); // pushes this enemy out of its neighbours in enemyGrid, run in order on the simulation thread
     virtual void Draw();
     virtual void TakeDamage(int dmg, Vector2 hitDirection);
-    void Reset(Vector2 pos, EnemyType t, int baseHp, int baseDmg, float spd, float range);
+    void Reset(Vector2 pos, EnemyType t);
+    void Deactivate() { alive = false; } // back to the pool without counting as a kill
+    void ApplyStats(); // speed, range, health and damage for its type at the current wave
 
     bool IsAlive() const;
     int GetDamage() const;
     Vector2 GetPosition() const;
     Rectangle GetHitbox() const;
     EnemyType GetType() const { return type; }
+    uint32_t GetId() const { return id; }
+    bool TakeShot(); // true once after Update() decided to shoot
+    void AddPendingTime(float dt);
+    float GetPendingTime() const { return pendingTime; }
+    float TakePendingTime(); // time to step this update, capped so a long wait isn't one jump through a wall. The
+                             // rest stays pending, so a waiting enemy catches up over its next turns
+    void SetScheduled(bool s) { scheduled = s; }
+    bool IsScheduled() const { return scheduled; }
 };
 
 // Preloaded textures for each enemy type
@@ -150,33 +426,266 @@ static Texture2D bigDemonFrames[4];
 
 std::vector<Enemy*> enemies;
 std::vector<Enemy*> enemyPool; // Object pool for enemies
+uint32_t nextEnemyId = 1;
+
+// Enemy level of detail: enemies on screen update every tick, the rest take turns catching up a few ticks at a time
+const float nearMargin = 48.0f; // pixels around the view that still count as on screen
+const float farInterval = 4.0f / 60.0f; // time an off-screen enemy waits between updates, and its longest step
+const int farUpdateBudget = 64; // most off-screen enemies updated per tick, however many there are
+// Longest an enemy can fall behind. Only reached when there are so many off-screen enemies that the budget can't keep
+// up, and then the rest is dropped rather than caught up at several times normal speed once they come into view
+const float maxPendingTime = 0.5f;
+size_t farCursor = 0; // where the next tick's turn-taking picks up in enemies
 
 class Goblin : public Enemy {
 public:
-    Goblin(Vector2 pos) : Enemy(pos, EnemyType::Goblin, goblinFrames, 30, 5, 1.5f, 80.0f) {}
+    Goblin(Vector2 pos) : Enemy(pos, EnemyType::Goblin, goblinFrames) {}
 };
 
 class Imp : public Enemy {
 public:
-    Imp(Vector2 pos) : Enemy(pos, EnemyType::Imp, impFrames, 20, 3, 2.0f, 90.0f) {}
+    Imp(Vector2 pos) : Enemy(pos, EnemyType::Imp, impFrames) {}
 };
 
 class BigZombie : public Enemy {
 public:
-    BigZombie(Vector2 pos) : Enemy(pos, EnemyType::BigZombie, bigZombieFrames, 50, 10, 1.2f, 100.0f) {}
+    BigZombie(Vector2 pos) : Enemy(pos, EnemyType::BigZombie, bigZombieFrames) {}
 };
 
 class BigDemon : public Enemy {
 public:
-    BigDemon(Vector2 pos) : Enemy(pos, EnemyType::BigDemon, bigDemonFrames, 80, 15, 1.3f, 120.0f) {}
+    BigDemon(Vector2 pos) : Enemy(pos, EnemyType::BigDemon, bigDemonFrames) {}
+};
+
+// Broadphase for anything that hits enemies (slashes, player contact, area attacks). A uniform grid of hitbox
+// centers, rebuilt whenever the enemies have moved, so a query only tests the enemies in nearby cells
+class EnemyGrid {
+public:
+    void Reserve(size_t maxEnemies); // room for that many enemies and the most cells, so Build() never allocates
+    void Build(const std::vector<Enemy*>& list);
+    // Fills out with the living enemies whose hitbox overlaps area, in the same order as the built list
+    void Query(Rectangle area, std::vector<Enemy*>& out);
+
+private:
+    static const int maxCellsPerAxis = 128; // cells get bigger instead when enemies are spread out
+    const std::vector<Enemy*>* source = nullptr;
+    Vector2 origin = {0, 0};
+    float cellSize = 32.0f;
+    float maxHalfExtent = 0.0f; // largest half width/height of a built hitbox, to widen queries by
+    int columns = 0;
+    int rows = 0;
+    std::vector<int> cellStart; // cell c holds cellItems[cellStart[c]] to cellItems[cellStart[c + 1]]
+    std::vector<int> cellItems; // indices into the built list, grouped by cell
+    std::vector<int> cellOf; // cell of each built enemy, scratch for Build()
+    std::vector<int> cellFill; // next free slot of each cell, scratch for Build()
+    std::vector<int> found; // scratch for Query()
+};
+
+EnemyGrid enemyGrid;
+std::vector<Enemy*> enemyHits; // enemyGrid query results, reused by everything that queries
+std::vector<Enemy*> scheduledEnemies; // enemies that update this tick
+
+enum class ProjectileOwner : uint8_t {
+    Player, // hits enemies
+    Enemy   // hits the player
+};
+
+// Everything that flies, stored as a struct of arrays so moving thousands of them is a few tight loops.
+// Live projectiles are packed at the front; removing one moves the last into its place
+class ProjectileSystem {
+public:
+    static const int capacity = 32768;
+
+    ProjectileSystem();
+    // Returns false when full. Velocity is in pixels per second
+    bool Spawn(Vector2 pos, Vector2 vel, float lifetime, ProjectileOwner owner, int damage);
+    void Update(float dt); // moves, expires, stops at walls and hits enemies (through enemyGrid) or the player
+    void Draw();
+    void Clear();
+    int Count() const { return (int)x.size(); }
+
+private:
+    void Remove(int i);
+
+    std::vector<float> x, y;
+    std::vector<float> velX, velY;
+    std::vector<float> life;
+    std::vector<int> damage;
+    std::vector<ProjectileOwner> owner;
+};
+
+ProjectileSystem projectiles;
+
+// Work-stealing job system. Every thread (the simulation thread is 0) has its own queue; threads take the
+// newest job from their own queue and steal the oldest from someone else's once theirs is empty
+class JobSystem {
+public:
+    void Start(int workerCount);
+    void Stop();
+    // Runs fn(begin, end) over [0, count) in chunks across all threads, returns when every chunk is done.
+    // Only called from the simulation thread, or from the main thread at startup before the simulation starts
+    void ParallelFor(int count, int chunkSize, const std::function<void(int, int)>& fn);
+
+private:
+    struct Job {
+        const std::function<void(int, int)>* fn; // the ParallelFor's, which outlives its jobs
+        int begin, end;
+        std::atomic<int>* remaining; // jobs left in the ParallelFor this belongs to
+    };
+    struct Queue {
+        std::mutex mutex;
+        RingBuffer<Job, 256> jobs; // a ParallelFor with more chunks than fit runs the rest itself
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<int> queuedJobs{0};
+    bool running = false; // guarded by sleepMutex
+
+    bool RunJob(int index); // runs one of our own or a stolen job, false if there was none
+    void WorkerLoop(int index);
+};
+
+JobSystem jobs;
+
+// Everything GameRender() needs from one simulation tick. Copies, so the simulation can keep going while it's drawn
+struct FrameSnapshot {
+    GameState gameState = GameState::StartScreen;
+    Camera2D camera = {};
+    Player player;
+    std::vector<Enemy> enemies; // only the living ones
+    SlashPool slashes;
+    ProjectileSystem projectiles;
+    ParticleSystem particles;
+    int currentWave = 1;
+    int waveCount = 8;
+    int totalKills = 0;
+    float fadeAlpha = 0.0f;
+    bool isAttackHovered = false;
+    bool isHpHovered = false;
+};
+
+// Triple buffer: the simulation fills one snapshot while the renderer draws another and the third holds the
+// newest finished one, so neither thread ever waits on the other
+class SnapshotBuffer {
+public:
+    void Reserve(size_t maxEnemies) { // room in every slot for that many enemies, so publishing never allocates
+        for (auto& slot : slots) slot.enemies.reserve(maxEnemies);
+    }
+    FrameSnapshot& WriteSlot() { return slots[writeIndex]; }
+    void Publish() { writeIndex = latest.exchange(writeIndex | freshBit) & indexMask; }
+    FrameSnapshot& Latest() {
+        if (latest.load() & freshBit) readIndex = latest.exchange(readIndex) & indexMask;
+        return slots[readIndex];
+    }
+
+private:
+    static const int freshBit = 4; // set while the middle slot holds a snapshot the renderer hasn't taken yet
+    static const int indexMask = 3;
+    FrameSnapshot slots[3];
+    int writeIndex = 0; // simulation thread only
+    int readIndex = 1; // main thread only
+    std::atomic<int> latest{2};
+};
+
+SnapshotBuffer snapshots;
+
+// Health bar and wave counters, drawn into their own texture only when one of the numbers changes and then
+// copied over the game in one draw. Main thread only, like all drawing
+class Hud {
+public:
+    static const int height = 48; // top strip of the 320x180 canvas
+
+    void Load();
+    void Unload();
+    void Refresh(FrameSnapshot& snap); // call outside any texture mode, raylib can't nest them
+    void Draw();
+
+private:
+    RenderTexture2D texture = {};
+    bool valid = false;
+    int health = 0, maxHealth = 0, wave = 0, kills = 0;
+    bool showWave = false;
+};
+
+Hud hud;
+
+// Puts the 320x180 canvas on the window. The scale and letterbox are worked out again only when the window size
+// changes, and everything that maps between window and canvas coordinates goes through here
+class Presenter {
+public:
+    static const int canvasWidth = 320;
+    static const int canvasHeight = 180;
+
+    void Load();
+    void Unload();
+    void Update(); // once a frame, before any mapping or drawing
+    Vector2 ScreenToCanvas(Vector2 p) const;
+    Vector2 CanvasToScreen(Vector2 p) const;
+    void Present(const RenderTexture2D& canvas); // draws the whole frame to the window
+    void ToggleIntegerScaling();
+    void ToggleShader();
+
+private:
+    void Recalculate();
+
+    int screenWidth = 0, screenHeight = 0;
+    float scale = 1.0f;
+    Rectangle dest = {0, 0, canvasWidth, canvasHeight}; // where the canvas lands on the window
+    bool integerScaling = true; // whole-number scales only, so every canvas pixel is the same size on screen
+    bool useShader = false; // sharp bilinear: smooth edges between pixels without blurring them
+    bool canvasBilinear = false; // filter currently set on the canvas texture
+    Shader shader = {};
+    int textureSizeLoc = -1;
+    int texelScaleLoc = -1;
+};
+
+Presenter presenter;
+
+// Watches the map's folder so saving the map, a tileset or an image in Tiled reloads it while playing. Uses inotify
+// on Linux; elsewhere the newest modification time of the folder's .tmx, .tsx, .tx and .png files is checked once a
+// second, like the wave table. Either way, tilesets and images kept in other folders aren't watched
+class MapWatcher {
+public:
+    void Start(const char* directory);
+    void Stop();
+    bool Poll(); // true once files were saved and then left alone for a moment, since one save writes several
+
+private:
+    double lastChange = -1.0; // GetTime() of the newest change not yet reported, negative when there is none
+#ifdef MAP_WATCH_INOTIFY
+    int fd = -1;
+#else
+    long NewestModTime() const;
+    const char* directory = nullptr;
+    long modTime = 0;
+    double nextCheck = 0.0;
+#endif
 };
 
+MapWatcher mapWatcher;
+std::thread simulationThread;
+std::atomic<bool> simulationRunning{false};
+std::atomic<bool> quitRequested{false};
+
 // Spawner positions
 std::vector<Vector2> goblinSpawners;
 std::vector<Vector2> impSpawners;
 std::vector<Vector2> bigZombieSpawners;
 std::vector<Vector2> bigDemonSpawners;
 
+// Spawns waiting for their turn. Spawner timers queue them here and a few come out each tick, instead of
+// every spawner emptying into the same tick
+struct PendingSpawn {
+    Vector2 pos;
+    EnemyType type;
+};
+RingBuffer<PendingSpawn, 1024> spawnQueue; // spawns that don't fit are dropped
+const int spawnsPerTick = 4;
+const int spawnJitter = 6; // pixels each way, so enemies from one spawner don't start stacked up
+
 // Spawn timers
 float smallEnemySpawnTimer = 0.0f;
 float bigEnemySpawnTimer = 0.0f;
@@ -187,9 +696,40 @@ float bigEnemySpawnInterval = 60.0f;
 // Wave system
 int currentWave = 1;
 int totalKills = 0;
-int requiredKills[8] = {15, 30, 50, 70, 110, 200, 350, 500};
 float playerDamage = 10.0f;
 
+// Enemy and wave tables, loaded from wavesFile and reloaded when it changes
+struct EnemyStats {
+    int hp;
+    int damage;
+    float speed;
+    float range;
+};
+
+const int maxWaves = 32;
+const int enemyTypeCount = 4; // indexed by EnemyType
+
+struct WaveTable {
+    EnemyStats enemies[enemyTypeCount]; // first wave stats
+    float hpGrowth; // per wave
+    float damageGrowth;
+    int waveCount;
+    int requiredKills[maxWaves]; // total kills to clear each wave
+    // Stats for every wave worked out once, so spawning is a lookup. Row waveCount is past the last wave
+    int scaledHp[maxWaves + 1][enemyTypeCount];
+    int scaledDamage[maxWaves + 1][enemyTypeCount];
+};
+
+const char* wavesFile = "assets/Data/waves.txt";
+// Used when the file is missing
+WaveTable waves = {
+    {{30, 5, 1.5f, 80.0f}, {20, 3, 2.0f, 90.0f}, {50, 10, 1.2f, 100.0f}, {80, 15, 1.3f, 120.0f}},
+    1.3f, 1.5f,
+    8, {15, 30, 50, 70, 110, 200, 350, 500}
+};
+long wavesModTime = 0;
+float wavesCheckTimer = 0.0f;
+
 // Upgrade system
 Texture2D attackCardTexture;
 Texture2D attackCardHoverTexture;
@@ -210,9 +750,9 @@ bool isFadingIn = false;
 bool isFadingOut = false;
 
 // Slash implementations
-void Slash::LoadAssets() {
+void Slash::LoadAssets(TexturePreloader& preloader) {
     for (int i = 0; i < 3; i++) {
-        frames[i] = LoadTexture(TextFormat("assets/Player/slash_f%d.png", i));
+        preloader.Add(&frames[i], TextFormat("assets/Player/slash_f%d.png", i));
     }
 }
 
@@ -228,6 +768,7 @@ Slash::Slash(Vector2 playerPos, Vector2 dir) {
     frame = 0;
     animTimer = 0.0f;
     finished = false;
+    hitCount = 0;
 }
 
 void Slash::Update(float dt) {
@@ -239,6 +780,17 @@ void Slash::Update(float dt) {
     }
 }
 
+bool Slash::TryHit(uint32_t enemyId) {
+    uint32_t* end = hitIds + hitCount;
+    uint32_t* at = std::lower_bound(hitIds, end, enemyId);
+    if (at != end && *at == enemyId) return false;
+    if (hitCount == maxHits) return false; // a swing can't hit more than maxHits enemies
+    std::copy_backward(at, end, end + 1);
+    *at = enemyId;
+    hitCount++;
+    return true;
+}
+
 void Slash::Draw() {
     if (finished) return;
 
@@ -262,12 +814,12 @@ Rectangle Slash::GetHitbox() {
 }
 
 // Player implementations
-void Player::Load() {
+void Player::Load(TexturePreloader& preloader) {
     for (int i = 0; i < 4; i++) {
-        idleAnim[i] = LoadTexture(("assets/Player/knight_f_idle_anim_f" + std::to_string(i) + ".png").c_str());
-        runAnim[i] = LoadTexture(("assets/Player/knight_f_run_anim_f" + std::to_string(i) + ".png").c_str()); 
+        preloader.Add(&idleAnim[i], "assets/Player/knight_f_idle_anim_f" + std::to_string(i) + ".png");
+        preloader.Add(&runAnim[i], "assets/Player/knight_f_run_anim_f" + std::to_string(i) + ".png");
     }
-    hitSprite = LoadTexture("assets/Player/knight_f_hit_anim_f0.png");
+    preloader.Add(&hitSprite, "assets/Player/knight_f_hit_anim_f0.png");
 }
 
 void Player::Unload() {
@@ -283,13 +835,16 @@ void Player::Update() {
 
     // Update timers
     if (damageCooldown > 0.0f) {
-        damageCooldown -= GetFrameTime();
+        damageCooldown -= frameDt;
     }
     if (dashCooldown > 0.0f) {
-        dashCooldown -= GetFrameTime();
+        dashCooldown -= frameDt;
+    }
+    if (shootCooldown > 0.0f) {
+        shootCooldown -= frameDt;
     }
     if (dashTimer > 0.0f) {
-        dashTimer -= GetFrameTime();
+        dashTimer -= frameDt;
         if (dashTimer <= 0.0f) {
             state = PlayerState::Idle; // End dash
         }
@@ -298,7 +853,7 @@ void Player::Update() {
     // If in hit or dash state, skip normal movement input
     if (state == PlayerState::Hit || state == PlayerState::Dash) {
         if (state == PlayerState::Hit) {
-            hitTimer -= GetFrameTime();
+            hitTimer -= frameDt;
             if (hitTimer <= 0.0f) {
                 state = PlayerState::Idle;
             }
@@ -309,32 +864,33 @@ void Player::Update() {
         }
     } else {
         // Movement input
-        if (IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D)) {
+        if (input.right) {
             vel.x = 2;
             facingRight = true;
         }
-        if (IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A)) {
+        if (input.left) {
             vel.x = -2;
             facingRight = false;
         }
-        if (IsKeyDown(KEY_UP) || IsKeyDown(KEY_W)) vel.y = -2;
-        if (IsKeyDown(KEY_DOWN) || IsKeyDown(KEY_S)) vel.y = 2;
+        if (input.up) vel.y = -2;
+        if (input.down) vel.y = 2;
 
         // Trigger dash
-        if ((IsKeyPressed(KEY_LEFT_SHIFT) || IsKeyPressed(KEY_RIGHT_SHIFT)) && dashCooldown <= 0.0f && (vel.x != 0 || vel.y != 0)) {
+        if (input.dashPressed && dashCooldown <= 0.0f && (vel.x != 0 || vel.y != 0)) {
             state = PlayerState::Dash;
             dashTimer = dashDuration;
             dashCooldown = dashCooldownDuration;
+            particles.Burst(pos, 10, LIGHTGRAY, 30.0f, 0.35f, 2.0f);
         }
 
         // Trigger hit
-        if (IsKeyPressed(KEY_SPACE)) {
+        if (input.hitPressed) {
             state = PlayerState::Hit;
             hitTimer = hitDuration;
             currentFrame = 0;
         }
 
-        if (IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_J)) {
+        if (input.attackPressed) {
             // attack and animation
             Vector2 dir = {0, 0};
             if (vel.x != 0 || vel.y != 0) {
@@ -342,7 +898,15 @@ void Player::Update() {
             } else {
                 dir = facingRight ? Vector2{1,0} : Vector2{-1,0};
             }
-            slashes.push_back(Slash(pos, dir));
+            slashes.Spawn(pos, dir);
+        }
+
+        // Throw a bolt the way the player is facing, it hits the first enemy in its path
+        if (input.shootPressed && shootCooldown <= 0.0f) {
+            Vector2 dir = facingRight ? Vector2{1, 0} : Vector2{-1, 0};
+            if (vel.x != 0 || vel.y != 0) dir = Vector2Normalize(vel);
+            projectiles.Spawn(pos, Vector2Scale(dir, 200.0f), 1.0f, ProjectileOwner::Player, (int)(playerDamage / 2));
+            shootCooldown = shootCooldownDuration;
         }
     }
 
@@ -354,57 +918,9 @@ void Player::Update() {
 
     // Check collision with Wall layer
     bool collision_x = false, collision_y = false;
-    if (wallLayer && wallLayer->type == LAYER_TYPE_TILE_LAYER && wallLayer->exact.tileLayer.tiles && (vel.x != 0 || vel.y != 0)) {
-        int tile_width = currentMap->tileWidth;
-        int tile_height = currentMap->tileHeight;
-
-        // Check x movement
-        if (vel.x != 0) {
-            int left_tile = (int)(new_rect_x.x) / tile_width;
-            int right_tile = (int)(new_rect_x.x + new_rect_x.width - 1) / tile_width;
-            int top_tile = (int)(new_rect_x.y) / tile_height;
-            int bottom_tile = (int)(new_rect_x.y + new_rect_x.height - 1) / tile_height;
-
-            left_tile = std::max(0, std::min(left_tile, (int)currentMap->width - 1));
-            right_tile = std::max(0, std::min(right_tile, (int)currentMap->width - 1));
-            top_tile = std::max(0, std::min(top_tile, (int)currentMap->height - 1));
-            bottom_tile = std::max(0, std::min(bottom_tile, (int)currentMap->height - 1));
-
-            for (int y = top_tile; y <= bottom_tile; y++) {
-                for (int x = left_tile; x <= right_tile; x++) {
-                    unsigned int tileID = wallLayer->exact.tileLayer.tiles[y * wallLayer->exact.tileLayer.width + x];
-                    if (tileID != 0) {
-                        collision_x = true;
-                        break;
-                    }
-                }
-                if (collision_x) break;
-            }
-        }
-
-        // Check y movement
-        if (vel.y != 0) {
-            int left_tile = (int)(new_rect_y.x) / tile_width;
-            int right_tile = (int)(new_rect_y.x + new_rect_y.width - 1) / tile_width;
-            int top_tile = (int)(new_rect_y.y) / tile_height;
-            int bottom_tile = (int)(new_rect_y.y + new_rect_y.height - 1) / tile_height;
-
-            left_tile = std::max(0, std::min(left_tile, (int)currentMap->width - 1));
-            right_tile = std::max(0, std::min(right_tile, (int)currentMap->width - 1));
-            top_tile = std::max(0, std::min(top_tile, (int)currentMap->height - 1));
-            bottom_tile = std::max(0, std::min(bottom_tile, (int)currentMap->height - 1));
-
-            for (int y = top_tile; y <= bottom_tile; y++) {
-                for (int x = left_tile; x <= right_tile; x++) {
-                    unsigned int tileID = wallLayer->exact.tileLayer.tiles[y * wallLayer->exact.tileLayer.width + x];
-                    if (tileID != 0) {
-                        collision_y = true;
-                        break;
-                    }
-                }
-                if (collision_y) break;
-            }
-        }
+    if (HasWallLayer() && (vel.x != 0 || vel.y != 0)) {
+        if (vel.x != 0) collision_x = IsWallInRect(new_rect_x);
+        if (vel.y != 0) collision_y = IsWallInRect(new_rect_y);
     }
 
     // Apply movement if no collision
@@ -417,7 +933,7 @@ void Player::Update() {
     }
 
     // Update animation frame
-    frameTimer += GetFrameTime();
+    frameTimer += frameDt;
     if (frameTimer >= frameTime) {
         frameTimer = 0.0f;
         currentFrame++;
@@ -476,73 +992,64 @@ Rectangle Player::GetHitbox() const {
 }
 
 // Enemy implementations
-Enemy::Enemy(Vector2 pos, EnemyType t, Texture2D* frames, int baseHp, int baseDmg, float spd, float range)
-    : position(pos), spawnPos(pos), runFrames(frames), currentFrame(0), frameTimer(0.0f), frameTime(0.15f), speed(spd),
-      alive(true), state(EnemyState::Chase), detectRange(range), target(pos), facingRight(true),
-      knockbackVelocity({0,0}), knockbackTimer(0.0f), type(t)
+Enemy::Enemy(Vector2 pos, EnemyType t, Texture2D* frames)
+    : position(pos), spawnPos(pos), runFrames(frames), currentFrame(0), frameTimer(0.0f), frameTime(0.15f),
+      alive(true), state(EnemyState::Chase), target(pos), facingRight(true),
+      knockbackVelocity({0,0}), knockbackTimer(0.0f), type(t), knockedBack(false), id(nextEnemyId++),
+      fireTimer(2.0f), wantsToFire(false), pendingTime(0.0f), scheduled(false)
 {
-    health = (int)(baseHp * pow(1.3f, currentWave - 1)); // 30% HP increase per wave
-    damage = (int)(baseDmg * pow(1.5f, currentWave - 1)); // 50% damage increase per wave
+    ApplyStats();
+}
+
+void Enemy::ApplyStats() {
+    int t = (int)type;
+    int wave = std::max(0, std::min(currentWave - 1, waves.waveCount));
+    speed = waves.enemies[t].speed;
+    detectRange = waves.enemies[t].range;
+    health = waves.scaledHp[wave][t];
+    damage = waves.scaledDamage[wave][t];
 }
 
 Enemy::~Enemy() {
     // Textures are managed globally, so no unloading here
 }
 
-void Enemy::Reset(Vector2 pos, EnemyType t, int baseHp, int baseDmg, float spd, float range) {
+void Enemy::Reset(Vector2 pos, EnemyType t) {
     position = pos;
     spawnPos = pos;
     type = t;
     currentFrame = 0;
     frameTimer = 0.0f;
     frameTime = 0.15f;
-    speed = spd;
-    health = (int)(baseHp * pow(1.3f, currentWave - 1)); // 30% HP increase per wave
-    damage = (int)(baseDmg * pow(1.5f, currentWave - 1)); // 50% damage increase per wave
+    ApplyStats();
     alive = true;
     state = EnemyState::Chase;
-    detectRange = range;
     target = pos;
     facingRight = true;
     knockbackVelocity = {0, 0};
     knockbackTimer = 0.0f;
+    knockedBack = false;
+    id = nextEnemyId++;
+    fireTimer = 2.0f;
+    wantsToFire = false;
+    pendingTime = 0.0f;
+    scheduled = false;
 }
 
 void Enemy::Update(float dt, const Player& player) {
     if (!alive) return;
 
     // If under knockback, apply it and reduce timer
-    if (knockbackTimer > 0.0f) {
+    knockedBack = knockbackTimer > 0.0f;
+    if (knockedBack) {
         Vector2 newPos = Vector2Add(position, Vector2Scale(knockbackVelocity, dt * 60));
         Rectangle newRect = {newPos.x - 8, newPos.y - 8, 16, 16};
 
         // Check wall collision for knockback
         bool collision_x = false, collision_y = false;
-        if (wallLayer && wallLayer->type == LAYER_TYPE_TILE_LAYER && wallLayer->exact.tileLayer.tiles) {
-            int tile_width = currentMap->tileWidth;
-            int tile_height = currentMap->tileHeight;
-
-            int left_tile = (int)(newRect.x) / tile_width;
-            int right_tile = (int)(newRect.x + newRect.width - 1) / tile_width;
-            int top_tile = (int)(newRect.y) / tile_height;
-            int bottom_tile = (int)(newRect.y + newRect.height - 1) / tile_height;
-
-            left_tile = std::max(0, std::min(left_tile, (int)currentMap->width - 1));
-            right_tile = std::max(0, std::min(right_tile, (int)currentMap->width - 1));
-            top_tile = std::max(0, std::min(top_tile, (int)currentMap->height - 1));
-            bottom_tile = std::max(0, std::min(bottom_tile, (int)currentMap->height - 1));
-
-            for (int y = top_tile; y <= bottom_tile; y++) {
-                for (int x = left_tile; x <= right_tile; x++) {
-                    unsigned int tileID = wallLayer->exact.tileLayer.tiles[y * wallLayer->exact.tileLayer.width + x];
-                    if (tileID != 0) {
-                        collision_x = true;
-                        collision_y = true; // Treat as full collision during knockback
-                        break;
-                    }
-                }
-                if (collision_x) break;
-            }
+        if (HasWallLayer() && IsWallInRect(newRect)) {
+            collision_x = true;
+            collision_y = true; // Treat as full collision during knockback
         }
 
         if (!collision_x && !collision_y) position = newPos;
@@ -564,67 +1071,47 @@ void Enemy::Update(float dt, const Player& player) {
     // Check wall collision
     Rectangle newRect = {newPos.x - 8, newPos.y - 8, 16, 16};
     bool collision_x = false, collision_y = false;
-    if (wallLayer && wallLayer->type == LAYER_TYPE_TILE_LAYER && wallLayer->exact.tileLayer.tiles) {
-        int tile_width = currentMap->tileWidth;
-        int tile_height = currentMap->tileHeight;
-
-        // Check x movement
-        if (newPos.x != position.x) {
-            int left_tile = (int)(newRect.x) / tile_width;
-            int right_tile = (int)(newRect.x + newRect.width - 1) / tile_width;
-            int top_tile = (int)(newRect.y) / tile_height;
-            int bottom_tile = (int)(newRect.y + newRect.height - 1) / tile_height;
-
-            left_tile = std::max(0, std::min(left_tile, (int)currentMap->width - 1));
-            right_tile = std::max(0, std::min(right_tile, (int)currentMap->width - 1));
-            top_tile = std::max(0, std::min(top_tile, (int)currentMap->height - 1));
-            bottom_tile = std::max(0, std::min(bottom_tile, (int)currentMap->height - 1));
-
-            for (int y = top_tile; y <= bottom_tile; y++) {
-                for (int x = left_tile; x <= right_tile; x++) {
-                    unsigned int tileID = wallLayer->exact.tileLayer.tiles[y * wallLayer->exact.tileLayer.width + x];
-                    if (tileID != 0) {
-                        collision_x = true;
-                        break;
-                    }
-                }
-                if (collision_x) break;
-            }
-        }
-
-        // Check y movement
-        if (newPos.y != position.y) {
-            int left_tile = (int)(newRect.x) / tile_width;
-            int right_tile = (int)(newRect.x + newRect.width - 1) / tile_width;
-            int top_tile = (int)(newRect.y) / tile_height;
-            int bottom_tile = (int)(newRect.y + newRect.height - 1) / tile_height;
-
-            left_tile = std::max(0, std::min(left_tile, (int)currentMap->width - 1));
-            right_tile = std::max(0, std::min(right_tile, (int)currentMap->width - 1));
-            top_tile = std::max(0, std::min(top_tile, (int)currentMap->height - 1));
-            bottom_tile = std::max(0, std::min(bottom_tile, (int)currentMap->height - 1));
-
-            for (int y = top_tile; y <= bottom_tile; y++) {
-                for (int x = left_tile; x <= right_tile; x++) {
-                    unsigned int tileID = wallLayer->exact.tileLayer.tiles[y * wallLayer->exact.tileLayer.width + x];
-                    if (tileID != 0) {
-                        collision_y = true;
-                        break;
-                    }
-                }
-                if (collision_y) break;
-            }
-        }
+    if (HasWallLayer()) {
+        if (newPos.x != position.x) collision_x = IsWallInRect(newRect);
+        if (newPos.y != position.y) collision_y = IsWallInRect(newRect);
     }
 
     // Apply movement if no wall collision
     if (!collision_x) position.x = newPos.x;
     if (!collision_y) position.y = newPos.y;
 
-    // Check collision with other enemies
+    // Update facing direction
+    if (dir.x != 0) facingRight = (dir.x > 0);
+
+    // Imps and big demons shoot at the player when close enough, demons less often but three at a time
+    if (type == EnemyType::Imp || type == EnemyType::BigDemon) {
+        fireTimer -= dt;
+        if (fireTimer <= 0.0f && Vector2Distance(position, player.pos) <= detectRange) {
+            fireTimer = type == EnemyType::BigDemon ? 3.0f : 2.0f;
+            wantsToFire = true;
+        }
+    }
+
+    // Animate
+    frameTimer += dt;
+    if (frameTimer > frameTime) {
+        frameTimer = 0.0f;
+        currentFrame = (currentFrame + 1) % 4;
+    }
+}
+
+void Enemy::Separate() {
+    if (!alive || knockedBack) return;
+
+    // Check collision with nearby enemies. The grid was built before separation started, and enemies resolved
+    // earlier this tick may have been pushed a little since, so the query is widened to still find them
+    const float pushSlack = 16.0f;
     Rectangle myHitbox = GetHitbox();
-    for (auto& other : enemies) {
-        if (other != this && other->IsAlive()) {
+    Rectangle nearby = {myHitbox.x - pushSlack, myHitbox.y - pushSlack,
+                        myHitbox.width + 2 * pushSlack, myHitbox.height + 2 * pushSlack};
+    enemyGrid.Query(nearby, enemyHits);
+    for (auto& other : enemyHits) {
+        if (other != this) {
             Rectangle otherHitbox = other->GetHitbox();
             if (CheckCollisionRecs(myHitbox, otherHitbox)) {
                 // Resolve overlap by moving away
@@ -636,16 +1123,6 @@ void Enemy::Update(float dt, const Player& player) {
             }
         }
     }
-
-    // Update facing direction
-    if (dir.x != 0) facingRight = (dir.x > 0);
-
-    // Animate
-    frameTimer += dt;
-    if (frameTimer > frameTime) {
-        frameTimer = 0.0f;
-        currentFrame = (currentFrame + 1) % 4;
-    }
 }
 
 void Enemy::Draw() {
@@ -667,6 +1144,7 @@ void Enemy::TakeDamage(int dmg, Vector2 hitDirection) {
         if (alive) {
             alive = false;
             totalKills++;
+            particles.Burst(position, 12, RED, 60.0f, 0.5f, 2.0f);
             // Heal player by 50% of max HP when a big enemy is defeated
             if (type == EnemyType::BigZombie || type == EnemyType::BigDemon) {
                 player.Heal(player.maxHealth / 2);
@@ -675,6 +1153,8 @@ void Enemy::TakeDamage(int dmg, Vector2 hitDirection) {
         return;
     }
 
+    particles.Burst(position, 4, WHITE, 40.0f, 0.2f, 1.0f);
+
     // Apply knockback
     Vector2 dirFromPlayer = Vector2Normalize(hitDirection); 
     knockbackVelocity = Vector2Scale(dirFromPlayer, 2.5f); // strength of knockback
@@ -690,6 +1170,429 @@ Rectangle Enemy::GetHitbox() const {
     return {position.x - 8, position.y - 8, 16, 16}; // Assume a 16x16 hitbox centered on position
 }
 
+// Enemy grid implementations
+void EnemyGrid::Reserve(size_t maxEnemies) {
+    int maxCells = (maxCellsPerAxis + 1) * (maxCellsPerAxis + 1); // the last cell on each axis can be a partial one
+    cellStart.reserve(maxCells + 1);
+    cellFill.reserve(maxCells);
+    cellItems.reserve(maxEnemies);
+    cellOf.reserve(maxEnemies);
+    found.reserve(maxEnemies);
+}
+
+void EnemyGrid::Build(const std::vector<Enemy*>& list) {
+    source = &list;
+    cellItems.resize(list.size());
+    cellOf.resize(list.size());
+    if (list.empty()) {
+        columns = rows = 0;
+        cellStart.assign(1, 0);
+        return;
+    }
+
+    // Fit the grid around every hitbox center
+    Vector2 minCenter = {FLT_MAX, FLT_MAX};
+    Vector2 maxCenter = {-FLT_MAX, -FLT_MAX};
+    maxHalfExtent = 0.0f;
+    for (Enemy* e : list) {
+        Rectangle box = e->GetHitbox();
+        Vector2 center = {box.x + box.width / 2, box.y + box.height / 2};
+        minCenter = {fminf(minCenter.x, center.x), fminf(minCenter.y, center.y)};
+        maxCenter = {fmaxf(maxCenter.x, center.x), fmaxf(maxCenter.y, center.y)};
+        maxHalfExtent = std::max(maxHalfExtent, std::max(box.width, box.height) / 2);
+    }
+    origin = minCenter;
+    float span = std::max(maxCenter.x - minCenter.x, maxCenter.y - minCenter.y);
+    cellSize = std::max(32.0f, span / maxCellsPerAxis);
+    columns = (int)((maxCenter.x - minCenter.x) / cellSize) + 1;
+    rows = (int)((maxCenter.y - minCenter.y) / cellSize) + 1;
+
+    // Counting sort by cell
+    cellStart.assign(columns * rows + 1, 0);
+    for (size_t i = 0; i < list.size(); i++) {
+        Rectangle box = list[i]->GetHitbox();
+        int cx = std::min(columns - 1, (int)((box.x + box.width / 2 - origin.x) / cellSize));
+        int cy = std::min(rows - 1, (int)((box.y + box.height / 2 - origin.y) / cellSize));
+        cellOf[i] = cy * columns + cx;
+        cellStart[cellOf[i] + 1]++;
+    }
+    for (int c = 0; c < columns * rows; c++) cellStart[c + 1] += cellStart[c];
+    cellFill.assign(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < list.size(); i++) cellItems[cellFill[cellOf[i]]++] = (int)i;
+}
+
+void EnemyGrid::Query(Rectangle area, std::vector<Enemy*>& out) {
+    out.clear();
+    if (columns == 0) return;
+
+    // Any center within half a hitbox of the area could overlap it
+    int x0 = std::max(0, (int)floorf((area.x - maxHalfExtent - origin.x) / cellSize));
+    int y0 = std::max(0, (int)floorf((area.y - maxHalfExtent - origin.y) / cellSize));
+    int x1 = std::min(columns - 1, (int)floorf((area.x + area.width + maxHalfExtent - origin.x) / cellSize));
+    int y1 = std::min(rows - 1, (int)floorf((area.y + area.height + maxHalfExtent - origin.y) / cellSize));
+
+    found.clear();
+    for (int cy = y0; cy <= y1; cy++) {
+        for (int cx = x0; cx <= x1; cx++) {
+            int c = cy * columns + cx;
+            for (int k = cellStart[c]; k < cellStart[c + 1]; k++) {
+                Enemy* e = (*source)[cellItems[k]];
+                if (e->IsAlive() && CheckCollisionRecs(area, e->GetHitbox())) found.push_back(cellItems[k]);
+            }
+        }
+    }
+    std::sort(found.begin(), found.end()); // list order, so results don't depend on the grid layout
+    for (int i : found) out.push_back((*source)[i]);
+}
+
+void Enemy::AddPendingTime(float dt) {
+    pendingTime = fminf(pendingTime + dt, maxPendingTime);
+}
+
+float Enemy::TakePendingTime() {
+    float step = fminf(pendingTime, farInterval);
+    pendingTime -= step;
+    return step;
+}
+
+bool Enemy::TakeShot() {
+    bool shot = wantsToFire && alive;
+    wantsToFire = false;
+    return shot;
+}
+
+// Particle implementations
+ParticleSystem::ParticleSystem() {
+    x.reserve(capacity);
+    y.reserve(capacity);
+    velX.reserve(capacity);
+    velY.reserve(capacity);
+    life.reserve(capacity);
+    invLifetime.reserve(capacity);
+    alpha.reserve(capacity);
+    size.reserve(capacity);
+    color.reserve(capacity);
+}
+
+float ParticleSystem::Random() {
+    // xorshift, so effects don't touch the shared rand() state
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return (seed >> 8) * (1.0f / 16777216.0f);
+}
+
+void ParticleSystem::Burst(Vector2 pos, int count, Color c, float speed, float lifetime, float particleSize) {
+    count = std::min(count, capacity - Count());
+    for (int i = 0; i < count; i++) {
+        float angle = Random() * 2 * PI;
+        float v = speed * (0.3f + 0.7f * Random());
+        float l = lifetime * (0.6f + 0.4f * Random());
+        x.push_back(pos.x);
+        y.push_back(pos.y);
+        velX.push_back(cosf(angle) * v);
+        velY.push_back(sinf(angle) * v);
+        life.push_back(l);
+        invLifetime.push_back(1.0f / l);
+        alpha.push_back(1.0f);
+        size.push_back(particleSize);
+        color.push_back(c);
+    }
+}
+
+void ParticleSystem::Remove(int i) {
+    int last = Count() - 1;
+    x[i] = x[last];
+    y[i] = y[last];
+    velX[i] = velX[last];
+    velY[i] = velY[last];
+    life[i] = life[last];
+    invLifetime[i] = invLifetime[last];
+    alpha[i] = alpha[last];
+    size[i] = size[last];
+    color[i] = color[last];
+    x.pop_back();
+    y.pop_back();
+    velX.pop_back();
+    velY.pop_back();
+    life.pop_back();
+    invLifetime.pop_back();
+    alpha.pop_back();
+    size.pop_back();
+    color.pop_back();
+}
+
+void ParticleSystem::Update(float dt) {
+    int n = Count();
+    float drag = fmaxf(0.0f, 1.0f - 4.0f * dt);
+
+    // Integrate, slow down and fade, one array at a time
+    for (int i = 0; i < n; i++) x[i] += velX[i] * dt;
+    for (int i = 0; i < n; i++) y[i] += velY[i] * dt;
+    for (int i = 0; i < n; i++) velX[i] *= drag;
+    for (int i = 0; i < n; i++) velY[i] *= drag;
+    for (int i = 0; i < n; i++) life[i] -= dt;
+    for (int i = 0; i < n; i++) alpha[i] = fmaxf(0.0f, life[i] * invLifetime[i]);
+
+    // Cull backwards, so the particle swapped into a gap has already been checked
+    for (int i = n - 1; i >= 0; i--) {
+        if (life[i] <= 0.0f) Remove(i);
+    }
+}
+
+void ParticleSystem::Draw() {
+    // Quads straight into raylib's batch, in chunks that always fit so it never has to flush mid-quad
+    const int chunk = 1024;
+    for (int start = 0; start < Count(); start += chunk) {
+        int end = std::min(Count(), start + chunk);
+        rlCheckRenderBatchLimit(4 * (end - start));
+        rlSetTexture(rlGetTextureIdDefault());
+        rlBegin(RL_QUADS);
+        for (int i = start; i < end; i++) {
+            float h = size[i] / 2;
+            rlColor4ub(color[i].r, color[i].g, color[i].b, (unsigned char)(color[i].a * alpha[i]));
+            rlVertex2f(x[i] - h, y[i] - h);
+            rlVertex2f(x[i] - h, y[i] + h);
+            rlVertex2f(x[i] + h, y[i] + h);
+            rlVertex2f(x[i] + h, y[i] - h);
+        }
+        rlEnd();
+        rlSetTexture(0);
+    }
+}
+
+void ParticleSystem::Clear() {
+    x.clear();
+    y.clear();
+    velX.clear();
+    velY.clear();
+    life.clear();
+    invLifetime.clear();
+    alpha.clear();
+    size.clear();
+    color.clear();
+}
+
+// Projectile implementations
+ProjectileSystem::ProjectileSystem() {
+    // Reserve everything up front so spawning never allocates
+    x.reserve(capacity);
+    y.reserve(capacity);
+    velX.reserve(capacity);
+    velY.reserve(capacity);
+    life.reserve(capacity);
+    damage.reserve(capacity);
+    owner.reserve(capacity);
+}
+
+bool ProjectileSystem::Spawn(Vector2 pos, Vector2 vel, float lifetime, ProjectileOwner who, int dmg) {
+    if (Count() >= capacity) return false;
+    x.push_back(pos.x);
+    y.push_back(pos.y);
+    velX.push_back(vel.x);
+    velY.push_back(vel.y);
+    life.push_back(lifetime);
+    damage.push_back(dmg);
+    owner.push_back(who);
+    return true;
+}
+
+void ProjectileSystem::Remove(int i) {
+    int last = Count() - 1;
+    x[i] = x[last];
+    y[i] = y[last];
+    velX[i] = velX[last];
+    velY[i] = velY[last];
+    life[i] = life[last];
+    damage[i] = damage[last];
+    owner[i] = owner[last];
+    x.pop_back();
+    y.pop_back();
+    velX.pop_back();
+    velY.pop_back();
+    life.pop_back();
+    damage.pop_back();
+    owner.pop_back();
+}
+
+void ProjectileSystem::Update(float dt) {
+    int n = Count();
+
+    // Move everything first, one array at a time
+    for (int i = 0; i < n; i++) x[i] += velX[i] * dt;
+    for (int i = 0; i < n; i++) y[i] += velY[i] * dt;
+    for (int i = 0; i < n; i++) life[i] -= dt;
+
+    Rectangle playerHitbox = player.GetHitbox();
+
+    // Backwards, so removing moves an already checked projectile into the gap
+    for (int i = n - 1; i >= 0; i--) {
+        bool spent = life[i] <= 0.0f;
+
+        // Stop at walls and the edge of the map
+        if (!spent && IsWallAt({x[i], y[i]})) spent = true;
+
+        if (!spent) {
+            Rectangle box = {x[i] - 1.5f, y[i] - 1.5f, 3, 3};
+            if (owner[i] == ProjectileOwner::Enemy) {
+                if (CheckCollisionRecs(box, playerHitbox)) {
+                    player.TakeDamage(damage[i]);
+                    spent = true;
+                }
+            } else {
+                enemyGrid.Query(box, enemyHits);
+                if (!enemyHits.empty()) {
+                    enemyHits[0]->TakeDamage(damage[i], {velX[i], velY[i]});
+                    spent = true;
+                }
+            }
+        }
+
+        if (spent) Remove(i);
+    }
+}
+
+void ProjectileSystem::Draw() {
+    // One batch of quads like the particles, in chunks that always fit so raylib never flushes mid-quad
+    const int chunk = 1024;
+    for (int start = 0; start < Count(); start += chunk) {
+        int end = std::min(Count(), start + chunk);
+        rlCheckRenderBatchLimit(4 * (end - start));
+        rlSetTexture(rlGetTextureIdDefault());
+        rlBegin(RL_QUADS);
+        for (int i = start; i < end; i++) {
+            Color color = owner[i] == ProjectileOwner::Enemy ? ORANGE : SKYBLUE;
+            rlColor4ub(color.r, color.g, color.b, color.a);
+            rlVertex2f(x[i] - 1.5f, y[i] - 1.5f);
+            rlVertex2f(x[i] - 1.5f, y[i] + 1.5f);
+            rlVertex2f(x[i] + 1.5f, y[i] + 1.5f);
+            rlVertex2f(x[i] + 1.5f, y[i] - 1.5f);
+        }
+        rlEnd();
+        rlSetTexture(0);
+    }
+}
+
+void ProjectileSystem::Clear() {
+    x.clear();
+    y.clear();
+    velX.clear();
+    velY.clear();
+    life.clear();
+    damage.clear();
+    owner.clear();
+}
+
+// Job system implementations
+void JobSystem::Start(int workerCount) {
+    for (int i = 0; i <= workerCount; i++) queues.emplace_back(new Queue());
+    running = true;
+    for (int i = 1; i <= workerCount; i++) workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+}
+
+void JobSystem::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        running = false;
+    }
+    wake.notify_all();
+    for (auto& t : workers) t.join();
+    workers.clear();
+    queues.clear();
+}
+
+void JobSystem::ParallelFor(int count, int chunkSize, const std::function<void(int, int)>& fn) {
+    if (count <= 0) return;
+    if (queues.size() <= 1 || count <= chunkSize) { // not worth waking anyone
+        fn(0, count);
+        return;
+    }
+
+    // Deal the chunks out round-robin so every thread starts with its own slice
+    int chunks = (count + chunkSize - 1) / chunkSize;
+    std::atomic<int> remaining{chunks};
+    for (int c = 0; c < chunks; c++) {
+        int begin = c * chunkSize;
+        int end = std::min(count, begin + chunkSize);
+        Queue& queue = *queues[c % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.PushBack({&fn, begin, end, &remaining})) {
+            fn(begin, end);
+            remaining--;
+            continue;
+        }
+        queuedJobs++;
+    }
+    { std::lock_guard<std::mutex> lock(sleepMutex); } // workers check queuedJobs under this, so none miss the wake
+    wake.notify_all();
+
+    // Help out until every chunk is done
+    while (remaining.load() > 0) {
+        if (!RunJob(0)) std::this_thread::yield();
+    }
+}
+
+bool JobSystem::RunJob(int index) {
+    Job job;
+    bool found = false;
+    {
+        // Newest job of our own first, it's the most likely to still be in cache
+        Queue& own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.Empty()) {
+            job = own.jobs.Back();
+            own.jobs.PopBack();
+            found = true;
+        }
+    }
+    // Otherwise steal the oldest job from the next thread that has one
+    for (size_t i = 1; !found && i < queues.size(); i++) {
+        Queue& victim = *queues[(index + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.Empty()) {
+            job = victim.jobs.Front();
+            victim.jobs.PopFront();
+            found = true;
+        }
+    }
+    if (!found) return false;
+
+    queuedJobs--;
+    (*job.fn)(job.begin, job.end);
+    job.remaining->fetch_sub(1);
+    return true;
+}
+
+void JobSystem::WorkerLoop(int index) {
+    while (true) {
+        if (RunJob(index)) continue;
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return !running || queuedJobs.load() > 0; });
+        if (!running) return;
+    }
+}
+
+// Texture preloader implementations
+void TexturePreloader::Add(Texture2D* texture, const std::string& path) {
+    *texture = {};
+    entries.push_back({texture, path, {}});
+}
+
+void TexturePreloader::DecodeAll() {
+    // PNG decoding is most of the time spent loading, and LoadImage() doesn't touch the GPU
+    jobs.ParallelFor((int)entries.size(), 1, [this](int begin, int end) {
+        for (int i = begin; i < end; i++) entries[i].image = LoadImage(entries[i].path.c_str());
+    });
+}
+
+void TexturePreloader::UploadAll() {
+    for (Entry& entry : entries) {
+        if (entry.image.data) *entry.texture = LoadTextureFromImage(entry.image);
+        UnloadImage(entry.image);
+    }
+    entries.clear();
+}
+
 // Globals
 Camera2D camera; // creates camera
 Texture2D startScreen; // Start screen texture
@@ -702,14 +1605,85 @@ bool fadingOut = false; // Track if fading to black
 Texture2D tilemap;
 RenderTexture2D target; // Camera size
 bool fullscreen = false;
+float escHoldTime = 0.0f; // how long escape has been held down while playing
+
+// Works out every wave's enemy stats up front
+void BuildScaledStats(WaveTable& table) {
+    for (int wave = 0; wave <= table.waveCount; wave++) {
+        for (int t = 0; t < enemyTypeCount; t++) {
+            table.scaledHp[wave][t] = (int)(table.enemies[t].hp * pow(table.hpGrowth, wave));
+            table.scaledDamage[wave][t] = (int)(table.enemies[t].damage * pow(table.damageGrowth, wave));
+        }
+    }
+}
+
+// Reads the wave file into table. Leaves table alone and returns false if the file can't be used
+bool LoadWaveTable(const char* fileName, WaveTable& table) {
+    char* text = LoadFileText(fileName);
+    if (!text) return false;
+
+    static const char* typeNames[enemyTypeCount] = {"goblin", "imp", "big_zombie", "big_demon"};
+    WaveTable loaded = table; // anything the file leaves out keeps its current value
+    loaded.waveCount = 0;
+    bool ok = true;
+    std::istringstream lines(text);
+    std::string line;
+    int lineNumber = 0;
+    while (ok && std::getline(lines, line)) {
+        lineNumber++;
+        std::istringstream words(line);
+        std::string keyword;
+        if (!(words >> keyword) || keyword[0] == '#') continue; // blank or comment
+
+        if (keyword == "enemy") {
+            std::string name;
+            EnemyStats stats;
+            ok = (bool)(words >> name >> stats.hp >> stats.damage >> stats.speed >> stats.range);
+            int t = (int)(std::find(typeNames, typeNames + enemyTypeCount, name) - typeNames);
+            if (ok && t < enemyTypeCount) loaded.enemies[t] = stats;
+            else ok = false;
+        } else if (keyword == "scaling") {
+            ok = (bool)(words >> loaded.hpGrowth >> loaded.damageGrowth);
+        } else if (keyword == "wave") {
+            ok = loaded.waveCount < maxWaves && (bool)(words >> loaded.requiredKills[loaded.waveCount]);
+            if (ok) loaded.waveCount++;
+        } else {
+            ok = false;
+        }
+        if (!ok) TraceLog(LOG_WARNING, "Bad line %d in %s: %s", lineNumber, fileName, line.c_str());
+    }
+    UnloadFileText(text);
+
+    if (ok && loaded.waveCount == 0) {
+        TraceLog(LOG_WARNING, "No waves in %s", fileName);
+        ok = false;
+    }
+    if (!ok) return false;
+
+    BuildScaledStats(loaded);
+    table = loaded;
+    return true;
+}
+
+// Reloads the wave file once a second if it was saved since the last load. Enemies already out keep their stats
+void CheckWaveTableReload(float dt) {
+    wavesCheckTimer += dt;
+    if (wavesCheckTimer < 1.0f) return;
+    wavesCheckTimer = 0.0f;
+
+    long modTime = GetFileModTime(wavesFile);
+    if (modTime == wavesModTime) return;
+    wavesModTime = modTime;
+    if (LoadWaveTable(wavesFile, waves)) TraceLog(LOG_INFO, "Reloaded %s", wavesFile);
+}
 
 // Load all enemy textures
-void LoadEnemyTextures() {
+void LoadEnemyTextures(TexturePreloader& preloader) {
     for (int i = 0; i < 4; i++) {
-        goblinFrames[i] = LoadTexture(("assets/Enemies/goblin_run_anim_f" + std::to_string(i) + ".png").c_str());
-        impFrames[i] = LoadTexture(("assets/Enemies/imp_run_anim_f" + std::to_string(i) + ".png").c_str());
-        bigZombieFrames[i] = LoadTexture(("assets/Enemies/big_zombie_run_anim_f" + std::to_string(i) + ".png").c_str());
-        bigDemonFrames[i] = LoadTexture(("assets/Enemies/big_demon_run_anim_f" + std::to_string(i) + ".png").c_str());
+        preloader.Add(&goblinFrames[i], "assets/Enemies/goblin_run_anim_f" + std::to_string(i) + ".png");
+        preloader.Add(&impFrames[i], "assets/Enemies/imp_run_anim_f" + std::to_string(i) + ".png");
+        preloader.Add(&bigZombieFrames[i], "assets/Enemies/big_zombie_run_anim_f" + std::to_string(i) + ".png");
+        preloader.Add(&bigDemonFrames[i], "assets/Enemies/big_demon_run_anim_f" + std::to_string(i) + ".png");
     }
 }
 
@@ -733,43 +1707,47 @@ void InitializeEnemyPool() {
     }
     // Set all pooled enemies to inactive
     for (auto& e : enemyPool) {
-        e->TakeDamage(9999, {0, 0}); // Ensure they're "dead"
+        e->Deactivate();
     }
+    // Everything that lists pooled enemies gets room for all of them now, so ticks don't allocate
+    enemies.reserve(enemyPool.size());
+    enemyHits.reserve(enemyPool.size());
+    scheduledEnemies.reserve(enemyPool.size());
+    enemyGrid.Reserve(enemyPool.size());
+    snapshots.Reserve(enemyPool.size());
 }
 
 // Get an enemy from the pool
 Enemy* GetEnemyFromPool(Vector2 pos, EnemyType type) {
     for (auto& e : enemyPool) {
         if (!e->IsAlive() && e->GetType() == type) {
-            switch (type) {
-                case EnemyType::Goblin:
-                    e->Reset(pos, type, 30, 5, 1.5f, 80.0f);
-                    break;
-                case EnemyType::Imp:
-                    e->Reset(pos, type, 20, 3, 2.0f, 90.0f);
-                    break;
-                case EnemyType::BigZombie:
-                    e->Reset(pos, type, 50, 10, 1.2f, 100.0f);
-                    break;
-                case EnemyType::BigDemon:
-                    e->Reset(pos, type, 80, 15, 1.3f, 120.0f);
-                    break;
-            }
+            e->Reset(pos, type);
             return e;
         }
     }
-    // If pool is exhausted, create a new enemy (fallback)
-    switch (type) {
-        case EnemyType::Goblin:
-            return new Goblin(pos);
-        case EnemyType::Imp:
-            return new Imp(pos);
-        case EnemyType::BigZombie:
-            return new BigZombie(pos);
-        case EnemyType::BigDemon:
-            return new BigDemon(pos);
-        default:
-            return nullptr;
+    // Pool is exhausted, the spawn is skipped until one of this type dies
+    return nullptr;
+}
+
+// Queues perSpawner enemies of a type at every spawner
+void QueueSpawns(const std::vector<Vector2>& spawners, EnemyType type, int perSpawner) {
+    for (int i = 0; i < perSpawner; i++) {
+        for (auto pos : spawners) spawnQueue.PushBack({pos, type});
+    }
+}
+
+// Spawns up to spawnsPerTick queued enemies, each nudged a little off its spawner
+void RunSpawnQueue() {
+    for (int n = 0; n < spawnsPerTick && !spawnQueue.Empty(); n++) {
+        PendingSpawn spawn = spawnQueue.Front();
+        spawnQueue.PopFront();
+
+        Vector2 pos = {spawn.pos.x + GetRandomValue(-spawnJitter, spawnJitter),
+                       spawn.pos.y + GetRandomValue(-spawnJitter, spawnJitter)};
+        if (IsWallAt(pos)) pos = spawn.pos; // jitter never pushes an enemy into a wall
+
+        Enemy* e = GetEnemyFromPool(pos, spawn.type);
+        if (e) enemies.push_back(e);
     }
 }
 
@@ -777,10 +1755,12 @@ Enemy* GetEnemyFromPool(Vector2 pos, EnemyType type) {
 void ResetGame() {
     // Clear active enemies
     for (auto& e : enemies) {
-        e->TakeDamage(9999, {0, 0}); // Return to pool by marking as dead
+        e->Deactivate(); // Return to pool
     }
     enemies.clear();
-    slashes.clear();
+    slashes.Clear();
+    projectiles.Clear();
+    particles.Clear();
 
     // Reset player
     player.pos = {160, 90};
@@ -795,11 +1775,13 @@ void ResetGame() {
     player.hitTimer = 0.0f;
     player.dashTimer = 0.0f;
     player.dashCooldown = 0.0f;
+    player.shootCooldown = 0.0f;
     playerDamage = 10.0f;
 
     // Reset spawn timers
     smallEnemySpawnTimer = 0.0f;
     bigEnemySpawnTimer = 0.0f;
+    spawnQueue.Clear();
     minuteTimer = 0.0f;
     smallEnemySpawnInterval = 5.0f;
     bigEnemySpawnInterval = 20.0f;
@@ -818,12 +1800,17 @@ void ResetGame() {
     PlayMusicStream(backgroundMusic);
 }
 
-// Defining everything for the game
-void GameStartup() {
-    printf("Hello");
-    currentMap = LoadTMX("assets/Tilemap/WAVESPAWN.tmx");
-    printf("Bye");
+// Finds the wall layer and spawners once the map has loaded, and again whenever it's reloaded
+void SetupMap() {
     wallLayer = nullptr;
+    goblinSpawners.clear();
+    impSpawners.clear();
+    bigZombieSpawners.clear();
+    bigDemonSpawners.clear();
+    if (!currentMap) {
+        TraceLog(LOG_ERROR, "Failed to load map: %s", mapFile);
+        return;
+    }
 
     // Find Wall tile layer
     for (uint32_t i = 0; i < currentMap->layersLength; i++) {
@@ -834,39 +1821,6 @@ void GameStartup() {
         }
     }
 
-    // Initialize audio
-    InitAudioDevice();
-    backgroundMusic = LoadMusicStream("assets/Sound/Pandora Palace.wav");
-    if (!IsMusicStreamPlaying(backgroundMusic)) {
-        TraceLog(LOG_WARNING, "Failed to load music: assets/Sound/Pandora Palace.wav");
-    }
-    SetMusicVolume(backgroundMusic, musicVolume);
-    PlayMusicStream(backgroundMusic);
-
-    // Load start screen
-    startScreen = LoadTexture("assets/Images/start.png");
-    if (startScreen.id == 0) {
-        TraceLog(LOG_WARNING, "Failed to load start screen texture: assets/Images/start.png");
-    }
-
-    // Load upgrade card textures
-    attackCardTexture = LoadTexture("assets/Images/attack.png");
-    attackCardHoverTexture = LoadTexture("assets/Images/attack1.png");
-    hpCardTexture = LoadTexture("assets/Images/hp.png");
-    hpCardHoverTexture = LoadTexture("assets/Images/hp1.png");
-    if (attackCardTexture.id == 0) {
-        TraceLog(LOG_WARNING, "Failed to load attack card texture: assets/Images/attack.png");
-    }
-    if (attackCardHoverTexture.id == 0) {
-        TraceLog(LOG_WARNING, "Failed to load attack hover texture: assets/Images/attack1.png");
-    }
-    if (hpCardTexture.id == 0) {
-        TraceLog(LOG_WARNING, "Failed to load hp card texture: assets/Images/hp.png");
-    }
-    if (hpCardHoverTexture.id == 0) {
-        TraceLog(LOG_WARNING, "Failed to load hp hover texture: assets/Images/hp1.png");
-    }
-
     // Collect spawner positions from object layer
     for (uint32_t i = 0; i < currentMap->layersLength; i++) {
         TmxLayer& layer = currentMap->layers[i];
@@ -887,16 +1841,70 @@ void GameStartup() {
             }
         }
     }
+}
+
+// Defining everything for the game
+void GameStartup() {
+    // Load the map in the background while the start screen is up
+    mapLoad = LoadTMXAsync(mapFile);
+    mapWatcher.Start(mapDirectory);
+
+    // One worker per spare core besides the render and simulation threads. Started first to decode the images
+    jobs.Start(std::max(0, (int)std::thread::hardware_concurrency() - 2));
+
+    // Every image is decoded across the job threads (the map's on its own loading thread), then uploaded at once
+    TexturePreloader preloader;
+    preloader.Add(&startScreen, "assets/Images/start.png");
+    preloader.Add(&attackCardTexture, "assets/Images/attack.png");
+    preloader.Add(&attackCardHoverTexture, "assets/Images/attack1.png");
+    preloader.Add(&hpCardTexture, "assets/Images/hp.png");
+    preloader.Add(&hpCardHoverTexture, "assets/Images/hp1.png");
+    player.Load(preloader);
+    Slash::LoadAssets(preloader);
+    LoadEnemyTextures(preloader);
+    preloader.DecodeAll();
+    preloader.UploadAll();
+
+    if (startScreen.id == 0) {
+        TraceLog(LOG_WARNING, "Failed to load start screen texture: assets/Images/start.png");
+    }
+    if (attackCardTexture.id == 0) {
+        TraceLog(LOG_WARNING, "Failed to load attack card texture: assets/Images/attack.png");
+    }
+    if (attackCardHoverTexture.id == 0) {
+        TraceLog(LOG_WARNING, "Failed to load attack hover texture: assets/Images/attack1.png");
+    }
+    if (hpCardTexture.id == 0) {
+        TraceLog(LOG_WARNING, "Failed to load hp card texture: assets/Images/hp.png");
+    }
+    if (hpCardHoverTexture.id == 0) {
+        TraceLog(LOG_WARNING, "Failed to load hp hover texture: assets/Images/hp1.png");
+    }
+
+    // Initialize audio
+    InitAudioDevice();
+    backgroundMusic = LoadMusicStream("assets/Sound/Pandora Palace.wav");
+    if (!IsMusicStreamPlaying(backgroundMusic)) {
+        TraceLog(LOG_WARNING, "Failed to load music: assets/Sound/Pandora Palace.wav");
+    }
+    SetMusicVolume(backgroundMusic, musicVolume);
+    PlayMusicStream(backgroundMusic);
 
     // Default player position
     player.pos = {160, 90};
 
     target = LoadRenderTexture(320, 180);
+    hud.Load();
+    presenter.Load();
     SetTextureFilter(target.texture, TEXTURE_FILTER_POINT);
 
-    player.Load();
-    Slash::LoadAssets();
-    LoadEnemyTextures();
+    // Wave tables before the pool, since enemies take their stats from them
+    BuildScaledStats(waves);
+    wavesModTime = GetFileModTime(wavesFile);
+    if (!LoadWaveTable(wavesFile, waves)) {
+        TraceLog(LOG_WARNING, "Failed to load wave table: %s, using the built-in one", wavesFile);
+    }
+
     InitializeEnemyPool();
 
     camera.target = player.pos;
@@ -911,7 +1919,7 @@ void GameStartup() {
 
 // Updates things every frame
 void GameUpdate() {
-    float dt = GetFrameTime();
+    float dt = frameDt;
 
     // Handle audio fade
     if (isFadingIn) {
@@ -953,8 +1961,8 @@ void GameUpdate() {
         }
     }
 
-    // Check if we need to switch states after fading to black
-    if (fadingOut && fadeAlpha >= 1.0f) {
+    // Check if we need to switch states after fading to black (stays black until the map is ready)
+    if (fadingOut && fadeAlpha >= 1.0f && mapReady.load()) {
         gameState = targetState;
         if (gameState == GameState::Playing) {
             ResetGame();
@@ -964,47 +1972,80 @@ void GameUpdate() {
 
     if (gameState == GameState::StartScreen) {
         // Check for any key press to start game
-        if ((IsKeyPressed(KEY_SPACE) || IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_J) || IsKeyPressed(KEY_ENTER)) && !fadingOut) {
+        if (input.startPressed && !fadingOut) {
             targetState = GameState::Playing;
             fadingOut = true;
         }
     } else if (gameState == GameState::Playing) {
-        // Toggle fullscreen (borderless) with Alt+Enter
-        if (IsKeyPressed(KEY_ENTER) && (IsKeyDown(KEY_LEFT_ALT) || IsKeyDown(KEY_RIGHT_ALT))) {
-            fullscreen = !fullscreen;
-            if (fullscreen) {
-                SetWindowState(FLAG_WINDOW_UNDECORATED | FLAG_WINDOW_TOPMOST);
-                SetWindowSize(GetMonitorWidth(0), GetMonitorHeight(0));
-                SetWindowPosition(0, 0);
-            } else {
-                ClearWindowState(FLAG_WINDOW_UNDECORATED | FLAG_WINDOW_TOPMOST);
-                SetWindowSize(1280, 720);
-                SetWindowPosition(100, 100);
+        player.Update();
+        camera.target = player.pos;
+
+        // Update slashes and remove finished ones
+        slashes.ForEach([dt](Slash& s) { s.Update(dt); });
+        slashes.ReleaseIf([](Slash& s) { return s.finished; });
+        enemyGrid.Build(enemies);
+        slashes.ForEach([](Slash& s) {
+            enemyGrid.Query(s.GetHitbox(), enemyHits);
+            for (auto& e : enemyHits) {
+                if (!s.TryHit(e->GetId())) continue; // each swing hits an enemy once
+                e->TakeDamage((int)playerDamage, Vector2Normalize(Vector2Subtract(e->GetPosition(), player.pos))); // player deals damage
             }
+        });
+
+        // Pick who updates: everyone near the view, plus off-screen enemies that have waited long enough, in
+        // turns and up to the budget, so far-away crowds cost a fixed amount per tick however big they get
+        scheduledEnemies.clear();
+        Rectangle nearArea = {camera.target.x - 160 - nearMargin, camera.target.y - 90 - nearMargin,
+                              320 + 2 * nearMargin, 180 + 2 * nearMargin};
+        size_t count = enemies.size();
+        int farBudget = farUpdateBudget;
+        for (size_t k = 0; k < count; k++) {
+            size_t i = (farCursor + k) % count;
+            Enemy* e = enemies[i];
+            e->AddPendingTime(dt);
+            bool onScreen = CheckCollisionPointRec(e->GetPosition(), nearArea);
+            bool due = !onScreen && farBudget > 0 && e->GetPendingTime() >= farInterval;
+            if (due && --farBudget == 0) farCursor = i + 1; // the next tick starts after the last one taken
+            e->SetScheduled(onScreen || due);
+            if (onScreen || due) scheduledEnemies.push_back(e);
         }
 
-        if (IsKeyDown(KEY_ESCAPE)) {
-            // hold down to quit after 3 seconds
-            static float escHoldTime = 0.0f;
-            if (IsKeyDown(KEY_ESCAPE)) {
-                escHoldTime += GetFrameTime();
-                if (escHoldTime >= 3.0f) {
-                    CloseWindow(); // exit game
+        // Enemies steer, hit walls and animate in parallel, each one only touching itself...
+        jobs.ParallelFor((int)scheduledEnemies.size(), 32, [](int begin, int end) {
+            for (int i = begin; i < end; i++) {
+                Enemy* e = scheduledEnemies[i];
+                e->Update(e->TakePendingTime(), player);
+            }
+        });
+
+        // ...then overlaps and damage are resolved in order on this thread, so threads don't change the outcome.
+        // Each enemy only looks at its neighbours in the grid, so this stays linear in the number of enemies
+        enemyGrid.Build(enemies);
+        for (auto& e : enemies) {
+            if (e->IsScheduled()) e->Separate();
+            if (e->TakeShot()) {
+                Vector2 dir = Vector2Normalize(Vector2Subtract(player.pos, e->GetPosition()));
+                if (e->GetType() == EnemyType::BigDemon) { // a slower spread of three
+                    for (float angle : {-0.3f, 0.0f, 0.3f}) {
+                        projectiles.Spawn(e->GetPosition(), Vector2Scale(Vector2Rotate(dir, angle), 70.0f), 3.0f,
+                                          ProjectileOwner::Enemy, e->GetDamage());
+                    }
+                } else {
+                    projectiles.Spawn(e->GetPosition(), Vector2Scale(dir, 90.0f), 2.0f, ProjectileOwner::Enemy,
+                                      e->GetDamage());
                 }
-            } else {
-                escHoldTime = 0.0f; // reset timer if key released
             }
         }
 
-        player.Update();
-        camera.target = player.pos;
+        // Projectiles and player contact are checked against a grid of where the enemies ended up
+        enemyGrid.Build(enemies);
+        projectiles.Update(dt);
+        particles.Update(dt);
 
         // Check player-enemy collisions
-        Rectangle playerHitbox = player.GetHitbox();
-        for (auto& e : enemies) {
-            if (e->IsAlive() && CheckCollisionRecs(playerHitbox, e->GetHitbox())) {
-                player.TakeDamage(e->GetDamage());
-            }
+        enemyGrid.Query(player.GetHitbox(), enemyHits);
+        for (auto& e : enemyHits) {
+            player.TakeDamage(e->GetDamage());
         }
 
         // Check for player death
@@ -1015,25 +2056,6 @@ void GameUpdate() {
             fadeTimer = 0.0f;
         }
 
-        // Update slashes
-        for (auto& s : slashes) s.Update(GetFrameTime());
-        for (auto& s : slashes) {
-            Rectangle hitbox = s.GetHitbox();
-            for (auto& e : enemies) {
-                if (e->IsAlive() && CheckCollisionRecs(hitbox, e->GetHitbox())) {
-                    e->TakeDamage((int)playerDamage, Vector2Normalize(Vector2Subtract(e->GetPosition(), player.pos))); // player deals damage
-                }
-            }
-        }
-        // Remove finished slashes
-        slashes.erase(
-            std::remove_if(slashes.begin(), slashes.end(),
-                [](Slash& s){ return s.finished; }),
-            slashes.end()
-        );
-
-        for (auto& e : enemies) e->Update(GetFrameTime(), player);
-
         // Move dead enemies back to pool
         enemies.erase(
             std::remove_if(enemies.begin(), enemies.end(),
@@ -1045,11 +2067,12 @@ void GameUpdate() {
         minuteTimer += dt;
 
         // Check for wave progression
-        if (currentWave <= 8 && totalKills >= requiredKills[currentWave - 1] && !showUpgradeScreen) {
+        if (currentWave <= waves.waveCount && totalKills >= waves.requiredKills[currentWave - 1] && !showUpgradeScreen) {
             player.maxHealth = (int)(player.maxHealth * 1.2f);
             player.health = player.maxHealth;
             playerDamage *= 1.1f;
             currentWave++;
+            particles.Burst(player.pos, 64, GOLD, 120.0f, 0.8f, 2.0f);
             // Increase spawn speed
             smallEnemySpawnInterval *= 0.9f;
             bigEnemySpawnInterval *= 0.9f;
@@ -1073,49 +2096,25 @@ void GameUpdate() {
 
         if (smallEnemySpawnTimer >= smallEnemySpawnInterval) {
             smallEnemySpawnTimer = 0.0f;
-            for (auto pos : goblinSpawners) {
-                for (int i = 0; i < 2; i++) { // Spawn 2 goblins
-                    Enemy* e = GetEnemyFromPool(pos, EnemyType::Goblin);
-                    if (e) enemies.push_back(e);
-                }
-            }
-            for (auto pos : impSpawners) {
-                for (int i = 0; i < 2; i++) { // Spawn 2 imps
-                    Enemy* e = GetEnemyFromPool(pos, EnemyType::Imp);
-                    if (e) enemies.push_back(e);
-                }
-            }
+            QueueSpawns(goblinSpawners, EnemyType::Goblin, 2); // 2 goblins each
+            QueueSpawns(impSpawners, EnemyType::Imp, 2); // 2 imps each
         }
 
         if (bigEnemySpawnTimer >= bigEnemySpawnInterval) {
             bigEnemySpawnTimer = 0.0f;
-            for (auto pos : bigZombieSpawners) {
-                Enemy* e = GetEnemyFromPool(pos, EnemyType::BigZombie);
-                if (e) enemies.push_back(e);
-            }
-            for (auto pos : bigDemonSpawners) {
-                Enemy* e = GetEnemyFromPool(pos, EnemyType::BigDemon);
-                if (e) enemies.push_back(e);
-            }
+            QueueSpawns(bigZombieSpawners, EnemyType::BigZombie, 1);
+            QueueSpawns(bigDemonSpawners, EnemyType::BigDemon, 1);
         }
+
+        RunSpawnQueue();
     } else if (gameState == GameState::UpgradeScreen) {
+        particles.Update(dt); // let the wave burst finish behind the cards
         // Check for mouse hover on upgrade cards
-        Vector2 mousePos = GetMousePosition();
-        float scaleX = (float)GetScreenWidth() / 320;
-        float scaleY = (float)GetScreenHeight() / 180;
-        float scale = fmin(scaleX, scaleY);
-        float offsetX = (GetScreenWidth() - 320 * scale) / 2;
-        float offsetY = (GetScreenHeight() - 180 * scale) / 2;
-        Vector2 renderMousePos = {
-            (mousePos.x - offsetX) / scale,
-            (mousePos.y - offsetY) / scale
-        };
-
-        isAttackHovered = CheckCollisionPointRec(renderMousePos, attackCardRect);
-        isHpHovered = CheckCollisionPointRec(renderMousePos, hpCardRect);
+        isAttackHovered = CheckCollisionPointRec(input.mouse, attackCardRect);
+        isHpHovered = CheckCollisionPointRec(input.mouse, hpCardRect);
 
         // Check for mouse click on upgrade cards
-        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+        if (input.clickPressed) {
             if (isAttackHovered) {
                 playerDamage *= 1.2f; // 20% attack boost
                 showUpgradeScreen = false;
@@ -1130,7 +2129,7 @@ void GameUpdate() {
     }
 
     // Check for game over
-    if (currentWave > 8 && !fadingOut && gameState != GameState::UpgradeScreen) {
+    if (currentWave > waves.waveCount && !fadingOut && gameState != GameState::UpgradeScreen) {
         targetState = GameState::StartScreen;
         fadingOut = true;
         isFadingOut = true;
@@ -1138,12 +2137,383 @@ void GameUpdate() {
     }
 }
 
+// Copies what the renderer needs into the free snapshot and hands it over
+void PublishSnapshot() {
+    FrameSnapshot& snap = snapshots.WriteSlot();
+    snap.gameState = gameState;
+    snap.camera = camera;
+    snap.player = player;
+    snap.enemies.clear(); // keeps the capacity reserved for the whole pool
+    for (auto& e : enemies) {
+        if (e->IsAlive()) snap.enemies.push_back(*e);
+    }
+    snap.slashes = slashes;
+    snap.projectiles = projectiles; // only copies the live ones, into capacity the slot already has
+    snap.particles = particles;
+    snap.currentWave = currentWave;
+    snap.waveCount = waves.waveCount;
+    snap.totalKills = totalKills;
+    snap.fadeAlpha = fadeAlpha;
+    snap.isAttackHovered = isAttackHovered;
+    snap.isHpHovered = isHpHovered;
+    snapshots.Publish();
+}
+
+// Runs the game at a fixed 60 ticks per second (movement is per tick) on its own thread
+void SimulationLoop() {
+    const auto tick = std::chrono::microseconds(16667);
+    auto nextTick = std::chrono::steady_clock::now();
+    while (simulationRunning.load()) {
+        // Take the input collected since the last tick
+        {
+            std::lock_guard<std::mutex> lock(inputMutex);
+            input = pendingInput;
+            pendingInput.dashPressed = pendingInput.hitPressed = pendingInput.attackPressed = false;
+            pendingInput.shootPressed = false;
+            pendingInput.startPressed = pendingInput.clickPressed = false;
+        }
+
+        {
+            AllowAllocations reload; // reading the file allocates, so this stays outside the checked tick
+            CheckWaveTableReload(frameDt);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mapMutex);
+            NoAllocations check; // debug builds assert if the tick touched the heap
+            GameUpdate();
+        }
+        {
+            NoAllocations check; // copies into capacity every slot reserved at startup
+            PublishSnapshot();
+        }
+
+        nextTick += tick;
+        auto now = std::chrono::steady_clock::now();
+        if (now - nextTick > std::chrono::milliseconds(100)) nextTick = now; // fell far behind, don't try to catch up
+        std::this_thread::sleep_until(nextTick);
+    }
+}
+
+// Main thread work each frame: input, window controls and finishing the map load (anything touching the GPU)
+void GameInput() {
+    const FrameSnapshot& snap = snapshots.Latest();
+    presenter.Update();
+
+    // F2 switches between whole-number and fill-the-window scaling, F3 toggles the smoothing shader
+    if (IsKeyPressed(KEY_F2)) presenter.ToggleIntegerScaling();
+    if (IsKeyPressed(KEY_F3)) presenter.ToggleShader();
+
+    // Presses are kept until the simulation takes them, so none are lost between ticks
+    Vector2 mousePos = presenter.ScreenToCanvas(GetMousePosition());
+    {
+        std::lock_guard<std::mutex> lock(inputMutex);
+        pendingInput.right = IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D);
+        pendingInput.left = IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A);
+        pendingInput.up = IsKeyDown(KEY_UP) || IsKeyDown(KEY_W);
+        pendingInput.down = IsKeyDown(KEY_DOWN) || IsKeyDown(KEY_S);
+        pendingInput.dashPressed |= IsKeyPressed(KEY_LEFT_SHIFT) || IsKeyPressed(KEY_RIGHT_SHIFT);
+        pendingInput.hitPressed |= IsKeyPressed(KEY_SPACE);
+        pendingInput.attackPressed |= IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_J);
+        pendingInput.shootPressed |= IsKeyPressed(KEY_X) || IsKeyPressed(KEY_K);
+        pendingInput.startPressed |= IsKeyPressed(KEY_SPACE) || IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_J) || IsKeyPressed(KEY_ENTER);
+        pendingInput.clickPressed |= IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
+        pendingInput.mouse = mousePos;
+    }
+
+    if (snap.gameState == GameState::Playing) {
+        // Toggle fullscreen (borderless) with Alt+Enter
+        if (IsKeyPressed(KEY_ENTER) && (IsKeyDown(KEY_LEFT_ALT) || IsKeyDown(KEY_RIGHT_ALT))) {
+            fullscreen = !fullscreen;
+            if (fullscreen) {
+                SetWindowState(FLAG_WINDOW_UNDECORATED | FLAG_WINDOW_TOPMOST);
+                SetWindowSize(GetMonitorWidth(0), GetMonitorHeight(0));
+                SetWindowPosition(0, 0);
+            } else {
+                ClearWindowState(FLAG_WINDOW_UNDECORATED | FLAG_WINDOW_TOPMOST);
+                SetWindowSize(1280, 720);
+                SetWindowPosition(100, 100);
+            }
+        }
+
+        // hold down to quit after 3 seconds
+        if (IsKeyDown(KEY_ESCAPE)) {
+            escHoldTime += GetFrameTime();
+            if (escHoldTime >= 3.0f) {
+                quitRequested = true; // exit game
+            }
+        } else {
+            escHoldTime = 0.0f; // reset timer if key released
+        }
+    }
+
+    // Upload the map's textures a couple of milliseconds per frame once it's loaded
+    if (mapLoad && PollTMXAsync(mapLoad, 0.002)) {
+        AllowAllocations setup; // spawner lists
+        currentMap = FinishTMXAsync(mapLoad);
+        mapLoad = nullptr;
+        SetupMap();
+        mapReady = true;
+    }
+
+    // Reload the map in the background once its files are saved. The new map is swapped in between frames, and
+    // only when the simulation isn't holding the map so this frame doesn't wait for a tick. It's a whole new map, so
+    // every chunk is built again rather than only those whose tiles changed, but UpdateTMXChunks() below builds them
+    // as they come into view instead of all at once
+    if (mapReady.load() && !mapReload && !reloadedMap && mapWatcher.Poll()) {
+        TraceLog(LOG_INFO, "Reloading %s", mapFile);
+        mapReload = LoadTMXAsync(mapFile);
+    }
+    if (mapReload && PollTMXAsync(mapReload, 0.002)) {
+        reloadedMap = FinishTMXAsync(mapReload);
+        mapReload = nullptr;
+        if (!reloadedMap) TraceLog(LOG_WARNING, "Failed to reload %s, keeping the old map", mapFile);
+    }
+    if (reloadedMap) {
+        std::unique_lock<std::mutex> lock(mapMutex, std::try_to_lock);
+        if (lock.owns_lock()) {
+            AllowAllocations setup;
+            TmxMap* oldMap = currentMap;
+            currentMap = reloadedMap;
+            reloadedMap = nullptr;
+            SetupMap(); // new wall layer and spawners; enemies already out stay where they are
+            lock.unlock();
+            UnloadTMX(oldMap);
+            TraceLog(LOG_INFO, "Reloaded %s", mapFile);
+        }
+    }
+
+    // Keep the meshes of the chunks around the camera's view resident. Only meshes are built and evicted, the tiles
+    // and collision bitmaps the simulation reads stay put, so this doesn't need the map lock. The map itself is only
+    // swapped on this thread, above
+    if (mapReady.load()) {
+        const float margin = 64.0f; // a few tiles, so chunks are ready before they scroll into view
+        Rectangle view = {
+            snap.camera.target.x - snap.camera.offset.x / snap.camera.zoom - margin,
+            snap.camera.target.y - snap.camera.offset.y / snap.camera.zoom - margin,
+            320.0f / snap.camera.zoom + margin * 2, 180.0f / snap.camera.zoom + margin * 2
+        };
+        UpdateTMXChunks(currentMap, view);
+    }
+}
+
+// Map watcher implementations
+void MapWatcher::Start(const char* directory) {
+#ifdef MAP_WATCH_INOTIFY
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    // Tiled writes files in place, other tools write a temporary file and rename it over the old one
+    if (fd >= 0 && inotify_add_watch(fd, directory, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        close(fd);
+        fd = -1;
+    }
+    if (fd < 0) TraceLog(LOG_WARNING, "Not watching %s for changes, the map won't hot reload", directory);
+#else
+    this->directory = directory;
+    modTime = NewestModTime();
+#endif
+}
+
+void MapWatcher::Stop() {
+#ifdef MAP_WATCH_INOTIFY
+    if (fd >= 0) close(fd);
+    fd = -1;
+#endif
+}
+
+bool MapWatcher::Poll() {
+#ifdef MAP_WATCH_INOTIFY
+    // Drain every queued event without blocking. Only the names of the files matter
+    alignas(inotify_event) char buffer[4096];
+    ssize_t length;
+    while (fd >= 0 && (length = read(fd, buffer, sizeof(buffer))) > 0) {
+        for (char* p = buffer; p < buffer + length;) {
+            const inotify_event* event = (const inotify_event*)p;
+            p += sizeof(inotify_event) + event->len;
+            if (event->len > 0 && IsFileExtension(event->name, ".tmx;.tsx;.tx;.png")) lastChange = GetTime();
+        }
+    }
+#else
+    if (GetTime() >= nextCheck) {
+        nextCheck = GetTime() + 1.0;
+        long time = NewestModTime();
+        if (time != modTime) {
+            modTime = time;
+            lastChange = GetTime();
+        }
+    }
+#endif
+
+    const double settleTime = 0.25; // seconds without changes before the files are taken as fully saved
+    if (lastChange < 0.0 || GetTime() - lastChange < settleTime) return false;
+    lastChange = -1.0;
+    return true;
+}
+
+#ifndef MAP_WATCH_INOTIFY
+long MapWatcher::NewestModTime() const {
+    FilePathList files = LoadDirectoryFilesEx(directory, ".tmx;.tsx;.tx;.png", false);
+    long newest = 0;
+    for (unsigned int i = 0; i < files.count; i++) newest = std::max(newest, GetFileModTime(files.paths[i]));
+    UnloadDirectoryFiles(files);
+    return newest;
+}
+#endif
+
+// Presentation implementations
+#if defined(PLATFORM_WEB)
+static const char* sharpBilinearShader =
+    "#version 100\n"
+    "precision mediump float;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "uniform vec2 textureSize;\n"
+    "uniform float texelScale;\n"
+    "void main() {\n"
+    "    vec2 texel = fragTexCoord * textureSize;\n"
+    "    vec2 dist = fract(texel) - 0.5;\n"
+    "    float region = max(0.0, 0.5 - 0.5 / texelScale);\n"
+    "    vec2 f = (dist - clamp(dist, -region, region)) * texelScale + 0.5;\n"
+    "    gl_FragColor = texture2D(texture0, (floor(texel) + f) / textureSize) * colDiffuse * fragColor;\n"
+    "}\n";
+#else
+static const char* sharpBilinearShader =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "uniform vec2 textureSize;\n"
+    "uniform float texelScale;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    vec2 texel = fragTexCoord * textureSize;\n"
+    "    vec2 dist = fract(texel) - 0.5;\n"
+    "    float region = max(0.0, 0.5 - 0.5 / texelScale);\n"
+    "    vec2 f = (dist - clamp(dist, -region, region)) * texelScale + 0.5;\n"
+    "    finalColor = texture(texture0, (floor(texel) + f) / textureSize) * colDiffuse * fragColor;\n"
+    "}\n";
+#endif
+
+void Presenter::Load() {
+    shader = LoadShaderFromMemory(nullptr, sharpBilinearShader);
+    textureSizeLoc = GetShaderLocation(shader, "textureSize");
+    texelScaleLoc = GetShaderLocation(shader, "texelScale");
+    screenWidth = screenHeight = 0; // recalculate on the first Update()
+}
+
+void Presenter::Unload() {
+    UnloadShader(shader);
+}
+
+void Presenter::Update() {
+    if (GetScreenWidth() != screenWidth || GetScreenHeight() != screenHeight) Recalculate();
+}
+
+void Presenter::Recalculate() {
+    screenWidth = GetScreenWidth();
+    screenHeight = GetScreenHeight();
+
+    scale = fminf((float)screenWidth / canvasWidth, (float)screenHeight / canvasHeight); // keep aspect ratio
+    if (integerScaling && scale >= 1.0f) scale = floorf(scale); // smaller windows than the canvas still fit it
+
+    dest.width = canvasWidth * scale;
+    dest.height = canvasHeight * scale;
+    dest.x = floorf((screenWidth - dest.width) / 2);
+    dest.y = floorf((screenHeight - dest.height) / 2);
+
+    Vector2 textureSize = {(float)canvasWidth, (float)canvasHeight};
+    SetShaderValue(shader, textureSizeLoc, &textureSize, SHADER_UNIFORM_VEC2);
+    SetShaderValue(shader, texelScaleLoc, &scale, SHADER_UNIFORM_FLOAT);
+}
+
+Vector2 Presenter::ScreenToCanvas(Vector2 p) const {
+    return {(p.x - dest.x) / scale, (p.y - dest.y) / scale};
+}
+
+Vector2 Presenter::CanvasToScreen(Vector2 p) const {
+    return {dest.x + p.x * scale, dest.y + p.y * scale};
+}
+
+void Presenter::Present(const RenderTexture2D& canvas) {
+    // The shader needs bilinear sampling to blend at pixel edges, plain scaling wants crisp points
+    if (canvasBilinear != useShader) {
+        canvasBilinear = useShader;
+        SetTextureFilter(canvas.texture, useShader ? TEXTURE_FILTER_BILINEAR : TEXTURE_FILTER_POINT);
+    }
+
+    BeginDrawing();
+    ClearBackground(BLACK);
+    if (useShader) BeginShaderMode(shader);
+    DrawTexturePro(
+        canvas.texture,
+        {0, 0, (float)canvas.texture.width, -(float)canvas.texture.height}, // flip Y
+        dest,
+        {0, 0}, 0, WHITE
+    );
+    if (useShader) EndShaderMode();
+    EndDrawing();
+}
+
+void Presenter::ToggleIntegerScaling() {
+    integerScaling = !integerScaling;
+    Recalculate();
+}
+
+void Presenter::ToggleShader() {
+    useShader = !useShader;
+}
+
+// HUD implementations
+void Hud::Load() {
+    texture = LoadRenderTexture(320, height);
+    SetTextureFilter(texture.texture, TEXTURE_FILTER_POINT);
+    valid = false;
+}
+
+void Hud::Unload() {
+    UnloadRenderTexture(texture);
+}
+
+void Hud::Refresh(FrameSnapshot& snap) {
+    bool wantWave = snap.currentWave <= snap.waveCount;
+    if (valid && health == snap.player.health && maxHealth == snap.player.maxHealth && wave == snap.currentWave &&
+        kills == snap.totalKills && showWave == wantWave) {
+        return;
+    }
+    health = snap.player.health;
+    maxHealth = snap.player.maxHealth;
+    wave = snap.currentWave;
+    kills = snap.totalKills;
+    showWave = wantWave;
+    valid = true;
+
+    BeginTextureMode(texture);
+    ClearBackground(BLANK);
+    snap.player.DrawHealthBar();
+    if (showWave) {
+        DrawText(TextFormat("WAVE %d", wave), 320 - 100, 10, 20, WHITE);
+        DrawText(TextFormat("KILLS: %d", kills), 320 - 100, 35, 10, WHITE);
+    }
+    EndTextureMode();
+}
+
+void Hud::Draw() {
+    // Render textures are upside down
+    DrawTextureRec(texture.texture, {0, 0, 320, -(float)height}, {0, 0}, WHITE);
+}
+
 void GameRender() {
+    // Draw the newest snapshot the simulation has finished
+    FrameSnapshot& snap = snapshots.Latest();
+    bool inGame = snap.gameState == GameState::Playing || snap.gameState == GameState::UpgradeScreen;
+    if (inGame) hud.Refresh(snap);
+
     // Draw to internal 320x180 canvas
     BeginTextureMode(target);
     ClearBackground(BLACK);
 
-    if (gameState == GameState::StartScreen) {
+    if (snap.gameState == GameState::StartScreen) {
         // Draw start screen
         if (startScreen.id != 0) {
             float scaleX = (float)320 / startScreen.width;
@@ -1161,30 +2531,26 @@ void GameRender() {
                 {0, 0}, 0.0f, WHITE
             );
         }
-    } else if (gameState == GameState::Playing || gameState == GameState::UpgradeScreen) {
-        BeginMode2D(camera);
-        DrawTMX(currentMap, &camera, 0, 0, WHITE);
-        player.Draw();
-        for (auto& s : slashes) s.Draw();
-        for (auto& e : enemies) e->Draw();
+    } else if (inGame) {
+        BeginMode2D(snap.camera);
+        DrawTMX(currentMap, &snap.camera, 0, 0, WHITE);
+        snap.player.Draw();
+        snap.slashes.ForEach([](Slash& s) { s.Draw(); });
+        snap.projectiles.Draw();
+        snap.particles.Draw();
+        for (auto& e : snap.enemies) e.Draw();
         EndMode2D();
 
-        // Draw health bar after camera mode (in screen space)
-        player.DrawHealthBar();
-
-        // Draw wave info
-        if (currentWave <= 8) {
-            DrawText(TextFormat("WAVE %d", currentWave), 320 - 100, 10, 20, WHITE);
-            DrawText(TextFormat("KILLS: %d", totalKills), 320 - 100, 35, 10, WHITE);
-        }
+        // Health bar and wave info after camera mode (in screen space)
+        hud.Draw();
 
         // Draw upgrade cards
-        if (gameState == GameState::UpgradeScreen) {
+        if (snap.gameState == GameState::UpgradeScreen) {
             // Semi-transparent overlay
             DrawRectangle(0, 0, 320, 180, Fade(BLACK, 0.5f));
 
             // Draw attack card
-            Texture2D currentAttackTexture = isAttackHovered ? attackCardHoverTexture : attackCardTexture;
+            Texture2D currentAttackTexture = snap.isAttackHovered ? attackCardHoverTexture : attackCardTexture;
             if (currentAttackTexture.id != 0) {
                 DrawTexturePro(
                     currentAttackTexture,
@@ -1196,7 +2562,7 @@ void GameRender() {
             }
 
             // Draw HP card
-            Texture2D currentHpTexture = isHpHovered ? hpCardHoverTexture : hpCardTexture;
+            Texture2D currentHpTexture = snap.isHpHovered ? hpCardHoverTexture : hpCardTexture;
             if (currentHpTexture.id != 0) {
                 DrawTexturePro(
                     currentHpTexture,
@@ -1210,37 +2576,21 @@ void GameRender() {
     }
 
     // Draw fade overlay
-    if (fadeAlpha > 0.0f) {
-        DrawRectangle(0, 0, 320, 180, Fade(BLACK, fadeAlpha));
+    if (snap.fadeAlpha > 0.0f) {
+        DrawRectangle(0, 0, 320, 180, Fade(BLACK, snap.fadeAlpha));
     }
 
     EndTextureMode();
 
     // Now draw the 320x180 canvas to the real window, scaled up
-    BeginDrawing();
-    ClearBackground(BLACK);
-
-    float scaleX = (float)GetScreenWidth() / 320;
-    float scaleY = (float)GetScreenHeight() / 180;
-    float scale = fmin(scaleX, scaleY); // keep aspect ratio
-
-    float finalWidth = 320 * scale;
-    float finalHeight = 180 * scale;
-    float offsetX = (GetScreenWidth() - finalWidth) / 2;
-    float offsetY = (GetScreenHeight() - finalHeight) / 2;
-
-    DrawTexturePro(
-        target.texture,
-        {0, 0, (float)target.texture.width, -(float)target.texture.height}, // flip Y
-        {offsetX, offsetY, finalWidth, finalHeight},
-        {0, 0}, 0, WHITE
-    );
-
-    EndDrawing();
+    presenter.Present(target);
 }
 
 // frees all resources
 void GameShutdown() {
+    simulationRunning = false;
+    simulationThread.join();
+    jobs.Stop();
     player.Unload();
     Slash::UnloadAssets();
     UnloadEnemyTextures();
@@ -1252,8 +2602,14 @@ void GameShutdown() {
     UnloadTexture(attackCardHoverTexture);
     UnloadTexture(hpCardTexture);
     UnloadTexture(hpCardHoverTexture);
+    if (mapLoad) currentMap = FinishTMXAsync(mapLoad); // Quit before the map finished loading
     UnloadTMX(currentMap); // Free the TMX map
+    mapWatcher.Stop();
+    if (mapReload) reloadedMap = FinishTMXAsync(mapReload); // Quit during a hot reload
+    UnloadTMX(reloadedMap);
     UnloadRenderTexture(target);
+    hud.Unload();
+    presenter.Unload();
     UnloadMusicStream(backgroundMusic); // Unload music
     CloseAudioDevice(); // Close audio device
     CloseWindow();
@@ -1266,9 +2622,25 @@ int main() {
     SetTargetFPS(60);
     GameStartup();
 
-    while (!WindowShouldClose()) {
-        GameUpdate();
-        GameRender();
+    // Start simulating, with a first snapshot so there's always one to draw
+    PublishSnapshot();
+    simulationRunning = true;
+    simulationThread = std::thread(SimulationLoop);
+
+    // GameUpdate() runs on the simulation thread, this one only reads input and draws
+    bool startupReported = false;
+    while (!WindowShouldClose() && !quitRequested) {
+        {
+            NoAllocations check; // a frame only allocates while loading a map, which allows it
+            GameInput();
+            GameRender();
+        }
+
+        // GetTime() counts from InitWindow(), so this is the whole startup: assets, map and the first frame drawn
+        if (!startupReported && mapReady.load()) {
+            TraceLog(LOG_INFO, "Startup: %.1f ms from InitWindow to the first playable frame", GetTime() * 1000.0);
+            startupReported = true;
+        }
     }
 
     GameShutdown();
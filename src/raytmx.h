@@ -172,6 +172,17 @@ typedef enum tmx_render_order {
     RENDER_ORDER_LEFT_UP /**< Tiles are rendered by row, from right to left, then column, from bottom to top. */
 } TmxRenderOrder;
 
+/**
+ * Identifiers for the shapes that tiles' collision information is flattened into when a map is loaded.
+ */
+typedef enum tmx_collision_shape_type {
+    COLLISION_SHAPE_BOX = 0, /**< Axis-aligned rectangle. Made from rectangles and from ellipses with unequal axes. */
+    COLLISION_SHAPE_CIRCLE, /**< Circle. Made from ellipses with equal axes. */
+    COLLISION_SHAPE_POINT, /**< Individual (X, Y) coordinate with no dimensions. */
+    COLLISION_SHAPE_CONVEX_POLYGON, /**< Convex polygon with pre-calculated edge normals and projections. */
+    COLLISION_SHAPE_OBJECT /**< Anything else, like concave polygons or polylines, checked as the original object. */
+} TmxCollisionShapeType;
+
 /**
  * Model of an <image> element. Defines an image and relevant attributes along with a loaded texture.
  */
@@ -184,17 +195,65 @@ typedef struct tmx_image {
     Texture2D texture; /**< The image as a raylib texture loaded into VRAM, if loading was successful. */
 } TmxImage;
 
+/**
+ * A single mesh of tile quads that share one texture, allowing a tile layer to be drawn with one draw call per texture
+ * rather than one per tile.
+ */
+typedef struct tmx_tile_batch {
+    Mesh mesh; /**< Two triangles per tile with UVs and flips already applied, relative to the layer's top-left. */
+    Material material; /**< Default material whose diffuse map is the texture shared by every tile in 'mesh.' */
+} TmxTileBatch;
+
+/**
+ * A rectangular piece of a tile layer whose meshes are built and evicted independently of the rest of the layer.
+ * Layers of infinite maps are stored as <chunk> elements. Layers of finite maps are split into chunks of
+ * RAYTMX_CHUNK_WIDTH by RAYTMX_CHUNK_HEIGHT tiles that refer to the layer's own array of GIDs.
+ * Every chunk's tiles and collision bitmap stay in memory. A resident chunk also has its meshes in VRAM. See
+ * UpdateTMXChunks().
+ */
+typedef struct tmx_tile_chunk {
+    int32_t x; /**< X coordinate, in tiles, of the chunk's top-left tile. May be negative in infinite maps. */
+    int32_t y; /**< Y coordinate, in tiles, of the chunk's top-left tile. May be negative in infinite maps. */
+    uint32_t width; /**< Width of the chunk in tiles. */
+    uint32_t height; /**< Height of the chunk in tiles. */
+    uint32_t* tiles; /**< Tile Global IDs (GIDs) of the chunk, or NULL if its data couldn't be decoded. Row 'y' of the
+                          chunk begins at tiles[y * tilesStride]. */
+    uint32_t tilesStride; /**< Distance between rows in 'tiles.' The chunk's width, or the map's width for chunks of
+                               finite maps. */
+    uint32_t* collisionBits; /**< Bitmap of one bit per tile, row by row, set when the tile has collision shapes. Each
+                                  row begins on a new 32-bit word. NULL when no tile in the chunk has any. */
+    TmxTileBatch* batches; /**< Array of meshes holding the chunk's static tiles, one or more per texture. */
+    uint32_t batchesLength; /**< Length of the 'batches' array. */
+    uint32_t* animatedTiles; /**< Array of indices, row * width + column, of animated tiles not in any batch. */
+    uint32_t animatedTilesLength; /**< Length of the 'animatedTiles' array. */
+    Rectangle bounds; /**< Area, in pixels relative to the layer, covered by the chunk's meshes and animated tiles.
+                           Larger tiles may extend beyond the chunk itself. */
+    bool isResident; /**< When true, the chunk's meshes are built. */
+    uint32_t lastUsed; /**< Value of the map's 'chunkClock' when the chunk was last within an area made resident. */
+    size_t residentBytes; /**< Memory, in bytes, that evicting the chunk would free. */
+} TmxTileChunk;
+
 /**
  * Model of a <layer> element when combined with the 'TmxLayer' model. Defines a tile layer with a fixed-size list of
- * tile Global IDs (GIDs).
+ * tile Global IDs (GIDs), or a set of chunks in infinite maps.
  */
 typedef struct tmx_tile_layer {
     uint32_t width; /**< Width of the layer in tiles. */
     uint32_t height; /**< Height of the layer in tiles. */
     char* encoding; /**< (Optional) encoding used to encode tiles. May be NULL, "base64," or "csv." */
     char* compression; /**< (Optional) compression used to compress tiles. May be NULL, "gzip," "zlib," or "zstd." */
-    uint32_t* tiles; /**< Array of tile Global IDs (GIDs) contained by this tile layer. */
+    uint32_t* tiles; /**< Array of tile Global IDs (GIDs) contained by this tile layer. NULL in infinite maps. */
     uint32_t tilesLength; /**< Length of the 'tiles' array. */
+    TmxTileChunk* chunks; /**< Array of the layer's chunks, which every tile layer is split into once loaded. */
+    uint32_t chunksLength; /**< Length of the 'chunks' array. */
+    uint32_t* chunkGrid; /**< (Optional) indices into 'chunks,' plus one, of the chunk in each cell of a grid covering
+                              the layer, row by row, or zero for empty cells. NULL if the chunks don't form a grid. */
+    int32_t chunkGridX; /**< X coordinate, in tiles, of the grid's top-left cell. */
+    int32_t chunkGridY; /**< Y coordinate, in tiles, of the grid's top-left cell. */
+    uint32_t chunkGridWidth; /**< Width of the grid in cells. */
+    uint32_t chunkGridHeight; /**< Height of the grid in cells. */
+    uint32_t chunkWidth; /**< Width, in tiles, of the layer's largest chunk and of the grid's cells. */
+    uint32_t chunkHeight; /**< Height, in tiles, of the layer's largest chunk and of the grid's cells. */
 } TmxTileLayer;
 
 /**
@@ -267,6 +326,17 @@ typedef struct tmx_object {
     Rectangle aabb; /**< Axis-Aligned Bounding Box (AABB). */
 } TmxObject;
 
+/**
+ * A node of the Bounding Volume Hierarchy (BVH) built over an object group's objects. Nodes are stored depth-first so
+ * a branch's left child immediately follows it.
+ */
+typedef struct tmx_object_group_node {
+    Rectangle aabb; /**< Axis-Aligned Bounding Box (AABB) enclosing every object beneath this node. */
+    uint32_t index; /**< For leaves, index into 'bvhObjects' of the leaf's first object. For branches, index into
+                         'bvhNodes' of the right child. */
+    uint32_t count; /**< Number of objects in the leaf, or zero if this node is a branch. */
+} TmxObjectGroupNode;
+
 /**
  * Model of an <objectgroup> element when combined with the 'TmxLayer' model. Defines an object layer of an arbitrary
  * number of objects of varying types.
@@ -280,6 +350,10 @@ typedef struct tmx_object_group {
     TmxObject* objects; /**< Array of objects contained by this object layer. */
     uint32_t objectsLength; /**< Length of the 'objects' array. */
     uint32_t* ySortedObjects; /**< Array of indexes of 'objects' sorted by the objects' y-coordinates. */
+    TmxObjectGroupNode* bvhNodes; /**< (Optional) BVH over the objects' AABBs used by collision checks. NULL when the
+                                       group is small enough that checking every object is just as fast. */
+    uint32_t bvhNodesLength; /**< Length of the 'bvhNodes' array. */
+    uint32_t* bvhObjects; /**< Array of indexes of 'objects' in the order the BVH's leaves reference them. */
 } TmxObjectGroup;
 
 /**
@@ -388,7 +462,8 @@ typedef struct tmx_tileset {
 } TmxTileset;
 
 /**
- * Contains the information and objects needed to quickly draw a <tile> in a raylib application.
+ * Contains the information needed to quickly draw a <tile> in a raylib application. This is read for every tile drawn
+ * so information that drawing doesn't need is kept separately, in TmxTileMetadata.
  */
 typedef struct tmx_tile {
     uint32_t gid; /**< Three possible uses: 1) If zero, indicates this tile is unused and the GID mapping to it doesn't
@@ -397,12 +472,51 @@ typedef struct tmx_tile {
     Rectangle sourceRect; /**< Sub-rectangle within a tileset to extract that is to be drawn. */
     Texture2D texture; /**< Texture in VRAM to be used to draw. May be used whole or as a source of a sub-rectangle. */
     Vector2 offset; /**< Offset in pixels to be applied to the tile, derived from the tileset. */
-    TmxAnimation animation; /**< (Optional) animation. */
-    bool hasAnimation; /**< When true, indicates 'animation' is set. */
+    bool hasAnimation; /**< When true, indicates the tile is an animation and 'frameGid' is set. */
+    uint32_t frameGid; /**< For animations, the GID of the tile to draw for the current frame. */
+} TmxTile;
+
+/**
+ * Information about a tile that isn't needed to draw it, like collision information and animation state.
+ */
+typedef struct tmx_tile_metadata {
+    TmxAnimation animation; /**< (Optional) animation. Set when the tile's 'hasAnimation' is true. */
     uint32_t frameIndex; /**< For animations, the current animation frame to draw. */
     float frameTime; /**< For animations, an accumulator. The time, in seconds, the current frame has been drawn. */
     TmxObjectGroup objectGroup; /**< (Optional) 0+ objects representing collision information unique to the tile. */
-} TmxTile;
+} TmxTileMetadata;
+
+/**
+ * A single piece of a tile's collision information, flattened from an object in the tile's <objectgroup>. Positions
+ * are relative to the top-left corner of the tile.
+ */
+typedef struct tmx_collision_shape {
+    TmxCollisionShapeType type; /**< The kind of shape, which determines the other fields that are set. */
+    Rectangle aabb; /**< Axis-Aligned Bounding Box (AABB) of the shape. For boxes, this is the shape itself. */
+    Vector2 center; /**< Center of a circle or the position of a point. */
+    float radius; /**< Radius of a circle. */
+    uint32_t pointsIndex; /**< For convex polygons, index of the first vertex and edge within the map's arrays. */
+    uint32_t pointsLength; /**< For convex polygons, the number of vertices, which is also the number of edges. */
+    uint32_t objectIndex; /**< Index of the object the shape was made from within the tile's object group. */
+} TmxCollisionShape;
+
+/**
+ * An edge of a convex collision polygon, as seen by the Separating Axis Theorem (SAT).
+ */
+typedef struct tmx_collision_edge {
+    Vector2 normal; /**< Unit vector perpendicular to the edge. */
+    float minimum; /**< Smallest projection of the polygon's vertices onto 'normal.' */
+    float maximum; /**< Largest projection of the polygon's vertices onto 'normal.' */
+} TmxCollisionEdge;
+
+/**
+ * The range of a tile's collision shapes within the map's array of them.
+ */
+typedef struct tmx_tile_collision {
+    uint32_t shapesIndex; /**< Index of the tile's first shape within the map's 'collisionShapes' array. */
+    uint32_t shapesLength; /**< Number of shapes the tile has. Zero if the tile has no collision information. */
+    bool isFullSquare; /**< When true, the tile's only shape is a box covering the whole tile. */
+} TmxTileCollision;
 
 /**
  * Model of a <map> element along with some pre-calculated objects for efficient drawing.
@@ -411,6 +525,7 @@ typedef struct tmx_map {
     char* fileName; /**< File name of the TMX file with extension. */
     TmxOrientation orientation; /**< Map orientation. May be orthogonal, isometric, staggered, or hexagonal. */
     TmxRenderOrder renderOrder; /**< Order in which tiles on tile layers are rendered. */
+    bool isInfinite; /**< When true, the map's tile layers are made of chunks that may extend in any direction. */
     uint32_t width; /**< Width of this map in tiles. */
     uint32_t height; /**< Height of htis map in tiles. */
     uint32_t tileWidth; /**< Width of a tile in pixels. */
@@ -427,12 +542,29 @@ typedef struct tmx_map {
     uint32_t layersLength; /**< Length of the 'layers' array. */
     TmxTile* gidsToTiles; /**< Array of pre-calculated tile metadata with all the values needed to quickly draw a tile
                                given its GID. Allocated such that gidsToTiles[1] returns the data of tile GID 1. */
+    TmxTileMetadata* gidsToTileMetadata; /**< Array of the remaining information about tiles, indexed the same way as
+                                              'gidsToTiles' and of the same length. */
     uint32_t gidsToTilesLength; /**< Length of the 'gidsToTiles' array. */
+    uint32_t* animatedGids; /**< Array of the GIDs whose tiles are animations. AnimateTMX() only visits these. */
+    uint32_t animatedGidsLength; /**< Length of the 'animatedGids' array. */
+    TmxTileCollision* gidsToCollision; /**< Array of the ranges of tiles' collision shapes, indexed the same way as
+                                            'gidsToTiles' and of the same length. NULL if no tile has any. */
+    TmxCollisionShape* collisionShapes; /**< Array of every tile's collision shapes, grouped by tile. */
+    uint32_t collisionShapesLength; /**< Length of the 'collisionShapes' array. */
+    Vector2* collisionPoints; /**< Array of the vertices of every convex polygon in 'collisionShapes.' */
+    TmxCollisionEdge* collisionEdges; /**< Array of the edges of every convex polygon, where an edge begins at the
+                                           vertex with the same index in 'collisionPoints.' */
+    uint32_t collisionPointsLength; /**< Length of the 'collisionPoints' and 'collisionEdges' arrays. */
+    size_t chunkMemoryBudget; /**< Memory, in bytes, that resident chunks may use before UpdateTMXChunks() evicts those
+                                   used least recently. Defaults to RAYTMX_CHUNK_MEMORY_BUDGET. */
+    size_t chunkMemoryUsed; /**< Memory, in bytes, used by resident chunks. */
+    uint32_t chunkClock; /**< Incremented by each call to UpdateTMXChunks() to tell recently-used chunks apart. */
 } TmxMap;
 
 /**
  * Given a path to TMX document, parse it and create an equivalent model that can be, among other uses, quickly drawn.
- * This function allocates memory and loads textures into VRAM. To clean up, use UnloadTMX().
+ * This function allocates memory and loads textures into VRAM. To clean up, use UnloadTMX(). Textures are shared with
+ * any other loaded maps using the same images so they are decoded and uploaded only once.
  *
  * @param fileName File name and/or path referencing a TMX document on disk to be loaded.
  * @return A model of the map as defined by the given TMX document, or NULL if loading failed for any reason.
@@ -441,12 +573,51 @@ RAYTMX_DEC TmxMap* LoadTMX(const char* fileName);
 
 /**
  * Unload a given map model by freeing memory allocations and unloading textures. In other words, free the resources
- * reserved by LoadTMX().
+ * reserved by LoadTMX(). Textures still used by another loaded map stay in VRAM, so loading the next map before
+ * unloading the current one lets them be reused.
  *
  * @param map A previously-loaded map model to be freed/unloaded.
  */
 RAYTMX_DEC void UnloadTMX(TmxMap* map);
 
+/**
+ * Handle to a map being loaded in the background by LoadTMXAsync(). Its contents are private.
+ */
+typedef struct tmx_async_load TmxAsyncLoad;
+
+/**
+ * Begin loading a TMX document without blocking. Parsing, decoding of layers, and decoding of images are done by a
+ * worker thread. Uploading textures to VRAM must happen on the main thread so it's left to PollTMXAsync(). Without
+ * thread support (i.e. RAYTMX_NO_THREADS or MSVC), the worker's part is done before this function returns.
+ *
+ * @param fileName File name and/or path referencing a TMX document on disk to be loaded.
+ * @return A handle to the load in progress to be polled with PollTMXAsync() and completed with FinishTMXAsync(), or
+ *         NULL if the load could not be started.
+ */
+RAYTMX_DEC TmxAsyncLoad* LoadTMXAsync(const char* fileName);
+
+/**
+ * Check on a map being loaded by LoadTMXAsync(). Once the worker thread is done, this uploads the map's textures to
+ * VRAM, taking roughly 'timeBudget' seconds per call, so it's intended to be called once per frame. At least one
+ * texture is uploaded per call regardless of the budget. The tables used for drawing and the tile layers' chunks are
+ * built by the last calls, but unlike LoadTMX(), no chunk is made resident: UpdateTMXChunks() builds the meshes of
+ * those in view, and chunks are drawn tile by tile until then.
+ *
+ * @param load Handle returned by LoadTMXAsync().
+ * @param timeBudget Time, in seconds, that may be spent uploading textures during this call.
+ * @return True when loading has finished, successfully or not, and FinishTMXAsync() will return immediately.
+ */
+RAYTMX_DEC bool PollTMXAsync(TmxAsyncLoad* load, double timeBudget);
+
+/**
+ * Complete a map load started by LoadTMXAsync(), blocking for whatever work remains, and free the handle. To cancel a
+ * load, call this and UnloadTMX() the result.
+ *
+ * @param load Handle returned by LoadTMXAsync(). It is no longer valid once this returns.
+ * @return A model of the map as defined by the given TMX document, or NULL if loading failed for any reason.
+ */
+RAYTMX_DEC TmxMap* FinishTMXAsync(TmxAsyncLoad* load);
+
 /**
  * Draw the entirety of the given map at the given position.
  * When a camera is also passed to this function, parallaxed scrolling can be applied to layers with parallax factors
@@ -484,12 +655,41 @@ RAYTMX_DEC void DrawTMXLayers(const TmxMap* map, const Camera2D* camera, const T
 
 /**
  * Progress the animations of the given map in real-time. This is intended to be called once per frame, or once per
- * BeginDrawing() an EndDrawing() call. If called more or less frequently, animation speeds will be affected.
+ * BeginDrawing() an EndDrawing() call. If called more or less frequently, animation speeds will be affected. Only the
+ * animated tiles listed in the map's 'animatedGids' are visited. Chunk meshes never contain animated tiles, which are
+ * drawn individually with their current frame, so no chunk needs rebuilding when a frame changes.
  *
  * @param map A loaded map model to be animated.
  */
 RAYTMX_DEC void AnimateTMX(TmxMap* map);
 
+/**
+ * Make the chunks of the given map's tile layers within the given area resident, then evict the chunks used least
+ * recently, outside the area, while resident chunks use more memory than the map's 'chunkMemoryBudget.' This is
+ * intended to be called once per frame with the camera's view, plus a margin, before drawing. Chunks within the area
+ * are made resident even if that exceeds the budget. A chunk is made resident by uploading its meshes to VRAM, so this
+ * must be called on the thread owning the graphics context. Only meshes are evicted: every chunk's tiles and collision
+ * bitmap, of finite and infinite maps alike, are decoded when the map is loaded and kept until it's unloaded, so
+ * collision checks and GetTMXTileLayerGid() see the whole map regardless of what's resident, and may be made by other
+ * threads during this call. Chunks without meshes are drawn tile by tile.
+ * Note: This function assumes the map is positioned at (0, 0). If the map is drawn with an offset, normalize.
+ *
+ * @param map A loaded map model whose chunks are to be made resident or evicted.
+ * @param area Area, in pixels, whose chunks are to be made resident.
+ */
+RAYTMX_DEC void UpdateTMXChunks(TmxMap* map, Rectangle area);
+
+/**
+ * Get the tile at the given position in a tile layer, whether the layer is made of chunks or not.
+ *
+ * @param map A loaded map model containing the given tile layer.
+ * @param tileLayer The tile layer to get the tile from.
+ * @param x X coordinate, in tiles, of the tile.
+ * @param y Y coordinate, in tiles, of the tile.
+ * @return The Global ID (GID), with possible flip flags, of the tile. Zero if there is no tile at the given position.
+ */
+RAYTMX_DEC uint32_t GetTMXTileLayerGid(const TmxMap* map, const TmxTileLayer* tileLayer, int32_t x, int32_t y);
+
 /**
  * Check for collisions between two objects of arbitrary type. Objects that are not primitive shapes, namely text and
  * tiles, are treated as rectangles.
@@ -546,6 +746,41 @@ RAYTMX_DEC bool CheckCollisionTMXTileLayersCircle(const TmxMap* map, const TmxLa
 RAYTMX_DEC bool CheckCollisionTMXTileLayersPoint(const TmxMap* map, const TmxLayer* layers, uint32_t layersLength,
     Vector2 point, TmxObject* outputObject);
 
+/**
+ * Check for collisions between the given tile or group layers and each of the given rectangles. This is equivalent to
+ * calling CheckCollisionTMXTileLayersRec() once per rectangle but the layers are only traversed once per call.
+ * Note: This function assumes the map is positioned at (0, 0). If the map is drawn with an offset, normalize.
+ *
+ * @param map A loaded map model containing the given layers.
+ * @param layers An array of select tile or group layers to be checked for collisions.
+ * @param layersLength Length of the given array of layers.
+ * @param recs An array of rectangles to be checked for collisions.
+ * @param recsLength Length of the given array of rectangles.
+ * @param results Output bitset of at least (recsLength + 31) / 32 values. Bit (i % 32) of results[i / 32] is set if
+ *                rectangle i collides with any tile in the given layers and cleared otherwise.
+ * @return The number of rectangles that collide with any tile in the given layers.
+ */
+RAYTMX_DEC uint32_t CheckCollisionTMXTileLayersRecs(const TmxMap* map, const TmxLayer* layers, uint32_t layersLength,
+    const Rectangle* recs, uint32_t recsLength, uint32_t* results);
+
+/**
+ * Check for collisions between the given tile or group layers and each of the given circles. This is equivalent to
+ * calling CheckCollisionTMXTileLayersCircle() once per circle but the layers are only traversed once per call.
+ * Note: This function assumes the map is positioned at (0, 0). If the map is drawn with an offset, normalize.
+ *
+ * @param map A loaded map model containing the given layers.
+ * @param layers An array of select tile or group layers to be checked for collisions.
+ * @param layersLength Length of the given array of layers.
+ * @param centers An array of the center points of the circles.
+ * @param radii An array of the radii of the circles, in the same order as 'centers.'
+ * @param circlesLength Length of the given arrays of centers and radii.
+ * @param results Output bitset of at least (circlesLength + 31) / 32 values. Bit (i % 32) of results[i / 32] is set if
+ *                circle i collides with any tile in the given layers and cleared otherwise.
+ * @return The number of circles that collide with any tile in the given layers.
+ */
+RAYTMX_DEC uint32_t CheckCollisionTMXTileLayersCircles(const TmxMap* map, const TmxLayer* layers,
+    uint32_t layersLength, const Vector2* centers, const float* radii, uint32_t circlesLength, uint32_t* results);
+
 /**
  * Check for collisions between the given tile or group layers and the given polygon. The tiles must have collision
  * information created with the Tiled Collision Editor.
@@ -684,6 +919,55 @@ RAYTMX_DEC void SetTraceLogFlagsTMX(int logFlags);
 #endif
 #include "hoxml.h"
 
+/* SSE2 is part of the x86-64 baseline so it's used without any extra compiler flags. Defining RAYTMX_NO_SIMD forces */
+/* the portable, scalar code paths on every platform. */
+#if !defined(RAYTMX_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define RAYTMX_SSE2
+    #include <emmintrin.h> /* _mm_loadu_si128(), _mm_cmpgt_epi8(), _mm_movemask_epi8(), etc. */
+#endif
+
+/* Layers and external tilesets are loaded by a pool of POSIX threads, which MinGW provides as well. Defining */
+/* RAYTMX_NO_THREADS, or building with MSVC, runs the same work serially on the calling thread instead. */
+#if !defined(RAYTMX_NO_THREADS) && !defined(_MSC_VER)
+    #define RAYTMX_THREADS
+    #include <pthread.h> /* pthread_create(), pthread_join(), pthread_mutex_lock(), etc. */
+#endif
+
+#ifndef RAYTMX_MAX_WORKER_THREADS
+    #define RAYTMX_MAX_WORKER_THREADS 4 /* Most threads, including the calling thread, that LoadTMX() will use */
+#endif
+
+#ifndef RAYTMX_OBJECTS_PER_LEAF
+    #define RAYTMX_OBJECTS_PER_LEAF 4 /* Most objects in a leaf of an object group's BVH. Smaller groups get no BVH. */
+#endif
+
+#ifndef RAYTMX_CHUNK_WIDTH
+    #define RAYTMX_CHUNK_WIDTH 16 /* Width, in tiles, of the chunks that finite maps' tile layers are split into */
+#endif
+
+#ifndef RAYTMX_CHUNK_HEIGHT
+    #define RAYTMX_CHUNK_HEIGHT 16 /* Height, in tiles, of the chunks that finite maps' tile layers are split into */
+#endif
+
+#ifndef RAYTMX_CHUNK_MEMORY_BUDGET
+    #define RAYTMX_CHUNK_MEMORY_BUDGET (16 * 1024 * 1024) /* Default bytes of resident chunks before any are evicted */
+#endif
+
+#ifndef RAYTMX_TEXTURE_CACHE_BUCKETS
+    #define RAYTMX_TEXTURE_CACHE_BUCKETS 64 /* Number of hash buckets in the texture cache. Must be a power of two. */
+#endif
+
+/* Storage for static buffers that must not be shared between threads, like the ones that hold returned paths */
+#if defined(__cplusplus)
+    #define RAYTMX_THREAD_LOCAL thread_local
+#elif defined(_MSC_VER)
+    #define RAYTMX_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+    #define RAYTMX_THREAD_LOCAL _Thread_local
+#else
+    #define RAYTMX_THREAD_LOCAL __thread
+#endif
+
 /******************/
 /* Implementation */
 
@@ -703,21 +987,36 @@ typedef enum raytmx_document_format {
     FORMAT_TX /* Object templates */
 } RaytmxDocumentFormat;
 
+struct raytmx_texture_request_node; /* Forward declaration */
+typedef struct raytmx_texture_request_node {
+    const char* source; /* The <image>'s 'source' string. Its address identifies the TmxImage wherever it's copied. */
+    char fullPath[512];
+    TmxImage* image; /* The image within the finished map that the texture is for */
+    Image decodedImage; /* Decoded ahead of time by LoadTMXAsync()'s thread, if it was, so only the upload remains */
+    struct raytmx_texture_request_node* next;
+} RaytmxTextureRequestNode; /* An <image> whose texture is loaded once its map is otherwise complete */
+
 typedef struct raytmx_external_tileset {
     TmxTileset tileset;
+    RaytmxTextureRequestNode* textureRequestsRoot; /* Textures for the tileset's images, relative to the TSX */
     bool isSuccess; /* 'isSuccess' is true when the external tileset was successfully loaded */
 } RaytmxExternalTileset;
 
 typedef struct raytmx_object_template {
     TmxTileset tileset;
     TmxObject object;
+    RaytmxTextureRequestNode* textureRequestsRoot; /* Textures for the tileset's images, relative to the TX or TSX */
     bool isSuccess, hasTileset; /* 'isSuccess' is true when the object template was successfully loaded */
 } RaytmxObjectTemplate;
 
 struct raytmx_cached_texture; /* Forward declaration */
 typedef struct raytmx_cached_texture {
     char* fileName;
+    uint32_t fileNameHash;
     Texture2D texture;
+    uint32_t referenceCount; /* Number of tilesets, tiles, and image layers, across all maps, using the texture */
+    long fileModTime; /* Modification time of the file when the texture was loaded */
+    bool isStale; /* When true, the file has changed since so the texture is only kept for those already using it */
     struct raytmx_cached_texture* next;
 } RaytmxCachedTextureNode; /* Associates a file name with a Texture2D allowing for the reuse of textures in VRAM */
 
@@ -790,20 +1089,70 @@ typedef struct raytmx_text_line_node {
     struct raytmx_text_line_node* next;
 } RaytmxTextLineNode;
 
+struct raytmx_chunk_node; /* Forward declaration */
+typedef struct raytmx_chunk_node {
+    TmxTileChunk chunk;
+    char* content; /* Copy of the <chunk>'s content, still encoded and possibly compressed, or NULL for <tile>s */
+    size_t contentLength;
+    struct raytmx_chunk_node* next;
+} RaytmxChunkNode;
+
+struct raytmx_pending_layer_node; /* Forward declaration */
+typedef struct raytmx_pending_layer_node {
+    TmxTileLayer* tileLayer; /* Points into a RaytmxLayerNode so it stays valid until the map's layers are copied */
+    const char* layerName;
+    TmxTileChunk* chunk; /* Set when the content is one <chunk>'s, decoded into the chunk instead of the layer */
+    char* content; /* Copy of the <data> element's content, still encoded and possibly compressed */
+    size_t contentLength;
+    struct raytmx_pending_layer_node* next;
+} RaytmxPendingLayerNode; /* A tile layer whose data is waiting to be decoded */
+
+struct raytmx_pending_tileset_node; /* Forward declaration */
+typedef struct raytmx_pending_tileset_node {
+    TmxTileset* tileset; /* Points into a RaytmxTilesetNode so it stays valid until the map's tilesets are copied */
+    char fullPath[512];
+    RaytmxExternalTileset externalTileset; /* Result of LoadTSX() once the tileset has been loaded */
+    struct raytmx_pending_tileset_node* next;
+} RaytmxPendingTilesetNode; /* A <tileset> whose external TSX file is waiting to be loaded */
+
+typedef struct raytmx_load_job {
+    RaytmxPendingLayerNode* pendingLayer; /* Exactly one of these two is set */
+    RaytmxPendingTilesetNode* pendingTileset;
+    size_t cost; /* Rough estimate of the work involved, used so the most expensive jobs are started first */
+} RaytmxLoadJob;
+
+typedef struct raytmx_load_job_queue {
+    RaytmxLoadJob* jobs;
+    uint32_t jobsLength, nextJob;
+#ifdef RAYTMX_THREADS
+    pthread_mutex_t mutex; /* Guards 'nextJob' */
+#endif
+} RaytmxLoadJobQueue; /* Jobs shared by the threads loading a map where each thread takes the next job until none remain */
+
+typedef struct raytmx_collision_query {
+    TmxCollisionShapeType type; /* Box, circle, or point. Anything else is an object. */
+    Rectangle aabb;
+    Vector2 center; /* Center of a circle or the position of a point */
+    float radius;
+    TmxObject object; /* The same shape as an object, for checks without a specialized path */
+} RaytmxCollisionQuery; /* A shape being checked for collisions with tiles */
+
 typedef struct raytmx_state {
     RaytmxDocumentFormat format;
     char documentDirectory[512];
     bool isSuccess;
+    /* <image>s are parsed without loading their textures. Uploading textures to the GPU must happen on the main */
+    /* thread, and parsing may not be, so each texture is requested and loaded once the map is otherwise complete. */
+    RaytmxTextureRequestNode *textureRequestsRoot, *textureRequestsTail;
 
     /* Variables intended for TMX (map) parsing */
-    RaytmxCachedTextureNode* texturesRoot;
     RaytmxCachedTemplateNode* templatesRoot;
     TmxOrientation mapOrientation;
     TmxRenderOrder mapRenderOrder;
     uint32_t mapWidth, mapHeight, mapTileWidth, mapTileHeight, mapPropertiesLength;
     int32_t mapParallaxOriginX, mapParallaxOriginY;
     Color mapBackgroundColor;
-    bool mapHasBackgroundColor;
+    bool mapHasBackgroundColor, mapIsInfinite;
     TmxProperty* mapProperties;
 
     /* These variables, when not NULL, are assigned to the current element(s) being parsed */
@@ -819,6 +1168,7 @@ typedef struct raytmx_state {
     TmxObjectGroup* objectGroup;
     TmxImageLayer* imageLayer;
     TmxObject* object;
+    TmxTileChunk* chunk;
 
     /* These variables are linked lists containing various elements where an arbitrary amount are allowed, such as */
     /* 1+ <object> elements in an <objectgroup>, that will be copied to arrays of known sizes later on */
@@ -828,13 +1178,64 @@ typedef struct raytmx_state {
     RaytmxAnimationFrameNode *animationFramesRoot, *animationFramesTail;
     RaytmxLayerNode *layersRoot, *layersTail, *groupNode;
     RaytmxTileLayerTileNode *layerTilesRoot, *layerTilesTail;
+    RaytmxChunkNode *chunksRoot, *chunksTail;
     RaytmxObjectNode *objectsRoot, *objectsTail;
     uint32_t tilesetsLength, tilesetTilesLength, animationFramesLength, propertiesLength, layersLength,
-        layerTilesLength, objectsLength, propertiesDepth;
+        layerTilesLength, chunksLength, objectsLength, propertiesDepth;
+
+    /* Work recorded during parsing of a TMX document that's done afterwards, in parallel, by LoadTMX() */
+    RaytmxPendingLayerNode *pendingLayersRoot, *pendingLayersTail;
+    RaytmxPendingTilesetNode *pendingTilesetsRoot, *pendingTilesetsTail;
+    uint32_t pendingLayersLength, pendingTilesetsLength;
+    bool isLayerDataPending; /* Whether the current <layer>'s <data> has been recorded for decoding */
 } RaytmxState; /* Intermediate data used internally to parse TMX (map), TSX (tileset), and TX (template) files */
 
+struct tmx_async_load {
+    char fileName[512];
+    TmxMap* map; /* Built by the worker thread, without textures or its GID tables, and NULL if loading failed */
+    RaytmxTextureRequestNode* textureRequestsRoot; /* Textures the main thread has yet to upload */
+    bool isDocumentLoaded; /* Set by the worker thread once 'map' and 'textureRequestsRoot' are ready */
+    bool areGidsBuilt; /* Set once the GID tables are built, which a poll does before the one building the chunks */
+    bool isFinished; /* Set once the textures are uploaded and the GID tables and chunks are built */
+#ifdef RAYTMX_THREADS
+    pthread_t thread;
+    pthread_mutex_t mutex; /* Guards 'isDocumentLoaded' */
+    bool isThreadRunning;
+#endif
+}; /* State of a map being loaded by LoadTMXAsync() */
+
 RaytmxExternalTileset LoadTSX(const char* fileName);
 RaytmxObjectTemplate LoadTX(const char* fileName);
+TmxMap* LoadTMXDocument(const char* fileName, RaytmxTextureRequestNode** textureRequestsRoot);
+void* RunAsyncLoad(void* asyncLoad);
+void BuildGidsToTiles(TmxMap* map);
+void BuildTileLayerChunks(TmxMap* map, TmxLayer* layers, uint32_t layersLength, bool makeResident);
+void BuildTileChunkGrid(TmxTileLayer* tileLayer);
+bool DecodeTileChunk(const TmxTileLayer* tileLayer, const char* layerName, TmxTileChunk* chunk, const char* content,
+    size_t contentLength);
+void BuildTileChunkCollision(const TmxMap* map, TmxTileChunk* chunk);
+void BuildTileChunkBatches(const TmxMap* map, TmxTileChunk* chunk);
+void LoadTileChunk(TmxMap* map, TmxTileChunk* chunk);
+void UnloadTileChunk(TmxMap* map, TmxTileChunk* chunk);
+void FreeTileChunkBatches(TmxTileChunk* chunk);
+void UpdateTileLayerChunks(TmxMap* map, TmxLayer* layers, uint32_t layersLength, Rectangle area);
+TmxTileChunk* FindLeastRecentChunk(TmxLayer* layers, uint32_t layersLength, uint32_t clock, TmxTileChunk* leastRecent);
+TmxTileChunk* NextTileChunk(const TmxTileLayer* tileLayer, int32_t fromX, int32_t fromY, int32_t toX, int32_t toY,
+    uint32_t* cursor);
+void BuildTileCollisionShapes(TmxMap* map);
+bool IsConvexPolygon(const Vector2* points, uint32_t pointsLength);
+void RunLoadJobs(RaytmxState* raytmxState);
+void* RunLoadJobQueue(void* queue);
+void RunLoadJob(RaytmxLoadJob* job);
+int CompareLoadJobs(const void* a, const void* b);
+void MergeExternalTileset(TmxTileset* tileset, RaytmxExternalTileset externalTileset);
+void AddTextureRequest(RaytmxState* raytmxState, const char* source);
+void AppendTextureRequests(RaytmxState* raytmxState, RaytmxTextureRequestNode* textureRequestsRoot);
+void DiscardTextureRequests(RaytmxState* raytmxState, const TmxTileset* tileset);
+RaytmxTextureRequestNode* FindRequestedImages(TmxMap* map, RaytmxTextureRequestNode* textureRequestsRoot);
+TmxImage* FindLayerImage(TmxLayer* layers, uint32_t layersLength, const char* source);
+RaytmxTextureRequestNode* LoadRequestedTexture(RaytmxTextureRequestNode* textureRequest);
+void FreeTextureRequests(RaytmxTextureRequestNode* textureRequestsRoot);
 void ParseDocument(RaytmxState* raytmxState, const char* fileName);
 void HandleElementBegin(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext);
 void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext);
@@ -849,13 +1250,25 @@ bool IterateTileLayer(const TmxMap* map, const TmxTileLayer* layer, Rectangle sc
     TmxTile* tile, Rectangle* tileRect);
 void DrawTMXTileLayer(const TmxMap* map, Rectangle screenRect, TmxLayer layer, int posX, int posY, Color tint);
 void DrawTMXLayerTile(const TmxMap* map, Rectangle screenRect, uint32_t rawGid, int posX, int posY, Color tint);
+void GetTileTexCoords(Texture2D texture, Rectangle source, bool flipX, bool flipY, bool flipDiag, Vector2* texCoords);
 void DrawTMXObjectTile(const TmxMap* map, Rectangle screenRect, uint32_t rawGid, int posX, int posY, float width,
     float height, Color tint);
 void DrawTMXObjectGroup(const TmxMap* map, Rectangle screenRect, TmxLayer layer, int posX, int posY, Color tint);
 void DrawTMXImageLayer(const TmxMap* map, Rectangle screenRect, TmxLayer layer, int posX, int posY, Color tint);
 bool CheckCollisionTMXTileLayerObject(const TmxMap* map, const TmxLayer* layers, uint32_t layersLength,
-    TmxObject object, TmxObject* outputObject);
+    const RaytmxCollisionQuery* query, TmxObject* outputObject);
+RaytmxCollisionQuery CreateCollisionQuery(TmxObject object);
+bool CheckCollisionTileShape(const TmxMap* map, const TmxCollisionShape* shape, Vector2 offset,
+    const RaytmxCollisionQuery* query, const TmxObject* object);
+bool CheckCollisionConvexPolygonQuery(const Vector2* points, const TmxCollisionEdge* edges, uint32_t pointsLength,
+    Vector2 offset, const RaytmxCollisionQuery* query);
+uint32_t CollectTileLayers(const TmxLayer* layers, uint32_t layersLength, const TmxTileLayer** tileLayers,
+    uint32_t tileLayersCapacity);
+bool CheckCollisionTMXTileLayerCells(const TmxMap* map, const TmxTileLayer* tileLayer,
+    const RaytmxCollisionQuery* query, TmxObject* outputObject);
 bool CheckCollisionTMXObjectGroupObject(TmxObjectGroup group, TmxObject object, TmxObject* outputObject);
+void BuildObjectGroupBvh(TmxObjectGroup* group);
+uint32_t BuildObjectGroupBvhNode(TmxObjectGroup* group, uint32_t first, uint32_t count, uint32_t* nodesLength);
 void TraceLogTMXTilesets(int logLevel, TmxOrientation orientation, TmxTileset* tilesets, uint32_t tilesetsLength,
     int numSpaces);
 void TraceLogTMXProperties(int logLevel, TmxProperty* properties, uint32_t propertiesLength, int numSpaces);
@@ -864,17 +1277,30 @@ void TraceLogTMXObject(int logLevel, TmxObject object, int numSpaces);
 void StringCopy(char* destination, const char* source);
 TmxProperty* AddProperty(RaytmxState* raytmxState);
 void AddTileLayerTile(RaytmxState* raytmxState, uint32_t gid);
+TmxTileChunk* AddChunk(RaytmxState* raytmxState);
 TmxTileset* AddTileset(RaytmxState* raytmxState);
 TmxTilesetTile* AddTilesetTile(RaytmxState* raytmxState);
 TmxAnimationFrame* AddAnimationFrame(RaytmxState* raytmxState);
 TmxLayer* AddGenericLayer(RaytmxState* raytmxState, bool isGroup);
 TmxObject* AddObject(RaytmxState* raytmxState);
+RaytmxPendingLayerNode* AddPendingLayer(RaytmxState* raytmxState);
+RaytmxPendingTilesetNode* AddPendingTileset(RaytmxState* raytmxState);
 void AppendLayerTo(TmxMap* map, RaytmxLayerNode* groupNode, RaytmxLayerNode* layersRoot, uint32_t layersLength);
-RaytmxCachedTextureNode* LoadCachedTexture(RaytmxState* raytmxState, const char* fileName);
+Texture2D LoadCachedTexture(const char* fullPath, const Image* decodedImage);
+void UnloadCachedTexture(Texture2D texture);
+bool IsTextureCached(const char* fullPath);
+bool IsCachedTextureCurrent(RaytmxCachedTextureNode* cachedTextureNode, const char* fullPath, uint32_t fileNameHash);
+uint32_t HashString(const char* str);
 RaytmxCachedTemplateNode* LoadCachedTemplate(RaytmxState* raytmxState, const char* fileName);
 Color GetColorFromHexString(const char* hex);
 uint32_t GetGid(uint32_t rawGid, bool* isFlippedHorizontally, bool* isFlippedVertically, bool* isFlippedDiagonally,
     bool* isRotatedHexagonal120);
+void DecodeTileLayerData(TmxTileLayer* tileLayer, const char* layerName, const char* content, size_t contentLength);
+bool DecodeBase64(const char* encoded, size_t encodedLength, unsigned char* output, size_t outputCapacity,
+    size_t* outputLength);
+uint32_t DecodeCsvTiles(const char* csv, size_t csvLength, uint32_t* tiles, uint32_t tilesCapacity);
+int CountTrailingZeros(uint32_t value);
+int32_t FloorDivide(int32_t dividend, int32_t divisor);
 void* MemAllocZero(unsigned int size);
 char* GetDirectoryPath2(const char* filePath);
 char* JoinPath(const char* prefix, const char* suffix);
@@ -885,161 +1311,17 @@ void StringConcatenate(char* destination, const char* source);
 /* Public implementation.                                                                                             */
 
 RAYTMX_DEC TmxMap* LoadTMX(const char* fileName) {
-    RaytmxState raytmxState[1];
-    memset(raytmxState, 0, sizeof(RaytmxState)); /* Initialize all values to zero, NULL, or an equivalent enum value */
-    raytmxState->format = FORMAT_TMX;
-
-    /* Initialize the map object */
-    TmxMap* map = (TmxMap*)MemAllocZero(sizeof(TmxMap));
-
-    /* Do format-agnostic parsing of the document. The state object will be populated with raytmx's models of the */
-    /* equivalent TMX, TSX, and/or TX elements. */
-    ParseDocument(raytmxState, fileName);
-    if (!raytmxState->isSuccess) {
-        UnloadTMX(map);
+    RaytmxTextureRequestNode* textureRequestsRoot = NULL;
+    TmxMap* map = LoadTMXDocument(fileName, &textureRequestsRoot);
+    if (map == NULL)
         return NULL;
-    }
-
-    /* Copy some top-level map properties */
-    map->fileName = (char*)MemAllocZero((unsigned int)strlen(fileName) + 1);
-    StringCopy(map->fileName, GetFileName(fileName));
-    map->orientation = raytmxState->mapOrientation;
-    map->renderOrder = raytmxState->mapRenderOrder;
-    map->width = raytmxState->mapWidth;
-    map->height = raytmxState->mapHeight;
-    map->tileWidth = raytmxState->mapTileWidth;
-    map->tileHeight = raytmxState->mapTileHeight;
-    map->backgroundColor = raytmxState->mapBackgroundColor;
-    map->parallaxOriginX = raytmxState->mapParallaxOriginX;
-    map->parallaxOriginY = raytmxState->mapParallaxOriginY;
-    map->hasBackgroundColor = raytmxState->mapHasBackgroundColor;
-
-    uint32_t gidsToTilesLength = 0; /* Can also be seen as the last GID */
-    if (raytmxState->tilesetsRoot != NULL) { /* If there is at least one tileset */
-        /* Allocate the array of tilesets and zeroize every index */
-        TmxTileset* tilesets = (TmxTileset*)MemAllocZero(sizeof(TmxTileset) * raytmxState->tilesetsLength);
-        /* Copy the TmxTileset pointers into the array */
-        RaytmxTilesetNode* tilesetIterator = raytmxState->tilesetsRoot;
-        for (uint32_t i = 0; tilesetIterator != NULL; i++) {
-            TmxTileset tileset = tilesetIterator->tileset;
-            if (tileset.hasImage) /* If the tileset has a shared image and implicitly defines tiles */
-                tileset.lastGid = tileset.firstGid + tileset.tileCount - 1;
-            else if (tileset.tilesLength > 0) /* If the tileset is a "collection of images" with explicit tiles */
-                tileset.lastGid = tileset.firstGid + tileset.tiles[tileset.tilesLength - 1].id - 1;
-
-            if (gidsToTilesLength < tileset.lastGid + 1)
-                gidsToTilesLength = tileset.lastGid + 1; /* GIDs start at 1 so the length is the last GID + 1 */
-            tilesets[i] = tileset;
-            tilesetIterator = tilesetIterator->next;
-        }
-        /* Add the tilesets array to the map */
-        map->tilesets = tilesets;
-        map->tilesetsLength = raytmxState->tilesetsLength;
-    } else
-        TraceLog(LOG_WARNING, "RAYTMX: The map does not contain any tilesets");
-
-    if (raytmxState->layersRoot != NULL) { /* If there is at least one layer within the map */
-        /* Due to the existence of <group> layers, layers can have children of multiple generations. To form the */
-        /* resulting tree-like structure, recursion is used. */
-        AppendLayerTo(map, NULL, raytmxState->layersRoot, raytmxState->layersLength);
-    } else
-        TraceLog(LOG_WARNING, "RAYTMX: The map does not contain any layers");
-
-    if (gidsToTilesLength > 0) {
-        TmxTile* gidsToTiles = (TmxTile*)MemAllocZero(sizeof(TmxTile) * gidsToTilesLength);
-
-        for (uint32_t i = 0; i < map->tilesetsLength; i++) {
-            TmxTileset* tileset = &map->tilesets[i];
-            if (tileset->hasImage) { /* If the tileset has a shared image (i.e. not a "collection of images") */
-                for (uint32_t id = 0; id < tileset->tileCount; id++) {
-                    uint32_t gid = id + tileset->firstGid, x = id % tileset->columns, y = id/ tileset->columns;
-                    bool hasExplicitSourceRect = false;
-                    gidsToTiles[gid].gid = gid;
-
-                    /* Search through the explicit tileset tiles for one with a matching local ID. Whereas most */
-                    /* tiles in a tile layer are implicit, some may have information given directly, like */
-                    /* animation frames or sub-rectangle values, as well as less relevant information. */
-                    for (uint32_t j = 0; j < tileset->tilesLength; j++) {
-                        TmxTilesetTile tilesetTile = tileset->tiles[j];
-                        if (tilesetTile.id == id) { /* If this tileset tile has explicitly-defined information */
-                            /* Typical tiles are implicit since everything that must be known about them can be */
-                            /* inferred from knowing the dimensions the tileset's image, dimensions of tiles, and */
-                            /* the (right-down) order of tiles within the tilest's image. However, tiles can have */
-                            /* additional, non-inferable information. This is particularly true for animations. */
-                            if (tilesetTile.hasAnimation) { /* If the tile is meta, pointing to other tiles */
-                                gidsToTiles[gid].hasAnimation = true;
-                                gidsToTiles[gid].animation = tilesetTile.animation;
-                                /* 'gid' is slightly repurposed for animations in that it's assigned with the */
-                                /* tileset's first GID rather than the tiles'. This is done because frames use */
-                                /* local IDs and the tileset's first GID is needed to get the frame's GID. */
-                                gidsToTiles[gid].gid = tileset->firstGid;
-                            } else if (tilesetTile.x != 0 || tilesetTile.y != 0 || tilesetTile.width != 0 ||
-                                    tilesetTile.height != 0) {
-                                /* This tile directly tells us the area within the tileset's image to use when */
-                                /* drawing, overriding the implicit dimensions derived from the map's 'tilewidth' */
-                                /* and 'tileheight' attributes. */
-                                hasExplicitSourceRect = true;
-                                gidsToTiles[gid].sourceRect.x = (float)tilesetTile.x;
-                                gidsToTiles[gid].sourceRect.y = (float)tilesetTile.y;
-                                gidsToTiles[gid].sourceRect.width = (float)tilesetTile.width;
-                                gidsToTiles[gid].sourceRect.height = (float)tilesetTile.height;
-                            }
-
-                            /* Tiles may have child object groups. These objects are a form of collision information. */
-                            /* The object group may be empty or may have objects. A simple assignment covers both. */
-                            gidsToTiles[gid].objectGroup = tilesetTile.objectGroup;
-
-                            break; /* The tile was found - no need to check the rest */
-                        }
-                    }
-
-                    if (!gidsToTiles[gid].hasAnimation) { /* If the tile is of the typical, static variety */
-                        if (!hasExplicitSourceRect) { /* If that section was not explicitly defined */
-                            /* Calculate the area within the texture to be drawn from contextual information */
-                            gidsToTiles[gid].sourceRect.x = (float)(tileset->margin + (x * tileset->tileWidth) +
-                                (x * tileset->spacing));
-                            gidsToTiles[gid].sourceRect.y = (float)(tileset->margin + (y * tileset->tileHeight) +
-                                (y * tileset->spacing));
-                            gidsToTiles[gid].sourceRect.width = (float)tileset->tileWidth;
-                            gidsToTiles[gid].sourceRect.height = (float)tileset->tileHeight;
-                        }
-                        gidsToTiles[gid].texture = tileset->image.texture;
-                        gidsToTiles[gid].offset.x = (float)tileset->tileOffsetX;
-                        gidsToTiles[gid].offset.y = (float)tileset->tileOffsetY;
-                    }
-                }
-            } else { /* If the tileset is a collection of images where each tile has its own image */
-                for (uint32_t j = 0; j < tileset->tilesLength; j++) {
-                    TmxTilesetTile tilesetTile = tileset->tiles[j];
-                    if (!tilesetTile.hasImage) {
-                        TraceLog(LOG_WARNING, "RAYTMX: Skipping tile %d of image collection tileset \"%s\" because "
-                            "it has no image", tilesetTile.id, tileset->name);
-                        continue;
-                    }
 
-                    int32_t gid = tileset->firstGid + tilesetTile.id;
-                    gidsToTiles[gid].gid = gid;
-                    gidsToTiles[gid].sourceRect.x = (float)tilesetTile.x; /* Defaults to and probably is zero */
-                    gidsToTiles[gid].sourceRect.y = (float)tilesetTile.y; /* Defaults to and probably is zero */
-                    if (tilesetTile.width != tilesetTile.image.width)
-                        gidsToTiles[gid].sourceRect.width = (float)tilesetTile.width;
-                    else
-                        gidsToTiles[gid].sourceRect.width = (float)tilesetTile.image.width;
-                    if (tilesetTile.height != tilesetTile.image.height)
-                        gidsToTiles[gid].sourceRect.height = (float)tilesetTile.height;
-                    else
-                        gidsToTiles[gid].sourceRect.height = (float)tilesetTile.image.height;
-                    gidsToTiles[gid].texture = tilesetTile.image.texture;
-                }
-            }
-        }
-
-        map->gidsToTiles = gidsToTiles;
-        map->gidsToTilesLength = gidsToTilesLength;
-    } /* gidsToTilesLength > 0 */
-
-    /* Free the linked lists and zeroize related values */
-    FreeState(raytmxState);
+    /* With every image in its final place within the map, load their textures */
+    while (textureRequestsRoot != NULL)
+        textureRequestsRoot = LoadRequestedTexture(textureRequestsRoot);
+    /* Build the tables used to draw tiles, which include copies of the textures, then the tile layers' chunks */
+    BuildGidsToTiles(map);
+    BuildTileLayerChunks(map, map->layers, map->layersLength, true);
 
     return map;
 }
@@ -1071,10 +1353,100 @@ RAYTMX_DEC void UnloadTMX(TmxMap* map) {
 
     if (map->gidsToTiles != NULL)
         MemFree(map->gidsToTiles);
+    if (map->gidsToTileMetadata != NULL)
+        MemFree(map->gidsToTileMetadata);
+    if (map->animatedGids != NULL)
+        MemFree(map->animatedGids);
+    if (map->gidsToCollision != NULL)
+        MemFree(map->gidsToCollision);
+    if (map->collisionShapes != NULL)
+        MemFree(map->collisionShapes);
+    if (map->collisionPoints != NULL)
+        MemFree(map->collisionPoints);
+    if (map->collisionEdges != NULL)
+        MemFree(map->collisionEdges);
 
     MemFree(map);
 }
 
+RAYTMX_DEC TmxAsyncLoad* LoadTMXAsync(const char* fileName) {
+    if (fileName == NULL)
+        return NULL;
+
+    TmxAsyncLoad* load = (TmxAsyncLoad*)MemAllocZero(sizeof(TmxAsyncLoad));
+    StringCopyN(load->fileName, fileName, sizeof(load->fileName) - 1);
+
+#ifdef RAYTMX_THREADS
+    pthread_mutex_init(&load->mutex, NULL);
+    if (pthread_create(&load->thread, NULL, RunAsyncLoad, load) == 0) {
+        load->isThreadRunning = true;
+        return load;
+    }
+    TraceLog(LOG_WARNING, "RAYTMX: Unable to start a thread to load \"%s\", loading it on this thread", fileName);
+#endif
+    RunAsyncLoad(load);
+    return load;
+}
+
+RAYTMX_DEC bool PollTMXAsync(TmxAsyncLoad* load, double timeBudget) {
+    if (load == NULL || load->isFinished)
+        return true;
+
+#ifdef RAYTMX_THREADS
+    if (load->isThreadRunning) {
+        pthread_mutex_lock(&load->mutex);
+        bool isDocumentLoaded = load->isDocumentLoaded;
+        pthread_mutex_unlock(&load->mutex);
+        if (!isDocumentLoaded) /* If the worker thread is still parsing and decoding */
+            return false;
+        pthread_join(load->thread, NULL);
+        load->isThreadRunning = false;
+    }
+#endif
+
+    /* Upload textures until they're all uploaded or the time budget has been spent */
+    double startTime = GetTime();
+    while (load->textureRequestsRoot != NULL) {
+        load->textureRequestsRoot = LoadRequestedTexture(load->textureRequestsRoot);
+        if (GetTime() - startTime >= timeBudget)
+            break;
+    }
+    if (load->textureRequestsRoot != NULL)
+        return false;
+
+    /* Then the GID tables and the chunks, in separate polls if the first leaves no time. The chunks' meshes are left */
+    /* to UpdateTMXChunks() which builds the ones in view, rather than uploading every mesh in one frame. */
+    if (load->map != NULL && !load->areGidsBuilt) {
+        BuildGidsToTiles(load->map);
+        load->areGidsBuilt = true;
+        if (GetTime() - startTime >= timeBudget)
+            return false;
+    }
+    if (load->map != NULL)
+        BuildTileLayerChunks(load->map, load->map->layers, load->map->layersLength, false);
+    load->isFinished = true;
+    return true;
+}
+
+RAYTMX_DEC TmxMap* FinishTMXAsync(TmxAsyncLoad* load) {
+    if (load == NULL)
+        return NULL;
+
+#ifdef RAYTMX_THREADS
+    if (load->isThreadRunning) {
+        pthread_join(load->thread, NULL);
+        load->isThreadRunning = false;
+    }
+    pthread_mutex_destroy(&load->mutex);
+#endif
+    /* Each poll uploads at least one texture so this always ends */
+    while (!PollTMXAsync(load, 0.0));
+
+    TmxMap* map = load->map;
+    MemFree(load);
+    return map;
+}
+
 RAYTMX_DEC void DrawTMX(const TmxMap* map, const Camera2D* camera, int posX, int posY, Color tint) {
     if (map == NULL)
         return;
@@ -1148,24 +1520,62 @@ RAYTMX_DEC void AnimateTMX(TmxMap* map) {
         return;
 
     float dt = GetFrameTime(); /* Returns the duration, in seconds, of the last frame drawn */
-    /* Iterate through the tiles, searching for those that are animations */
-    for (uint32_t gid = 0; gid < map->gidsToTilesLength; gid++) {
-        TmxTile* tile = &map->gidsToTiles[gid]; /* A pointer is used in case the frame time needs to be reassigned */
-        if (tile->gid > 0 && tile->hasAnimation) { /* If the GID maps to a valid tile and that tile is an animation */
-            tile->frameTime += dt;
-            /* If the current frame has been displayed for its whole duration, or longer */
-            if (tile->frameTime > tile->animation.frames[tile->frameIndex].duration) {
-                tile->frameTime -= tile->animation.frames[tile->frameIndex].duration;
-                /* Increment the frame index to display the next one... */
-                tile->frameIndex += 1;
-                /* ...unless the last frame was "last" in both senses */
-                if (tile->frameIndex == tile->animation.framesLength)
-                    tile->frameIndex = 0; /* Wrap around to the first frame */
-            }
+    /* Iterate through only the tiles that are animations, listed when the map was loaded */
+    for (uint32_t i = 0; i < map->animatedGidsLength; i++) {
+        uint32_t gid = map->animatedGids[i];
+        TmxTile* tile = &map->gidsToTiles[gid]; /* A pointer is used in case the frame needs to be reassigned */
+        TmxTileMetadata* metadata = &map->gidsToTileMetadata[gid];
+        metadata->frameTime += dt;
+        /* If the current frame has been displayed for its whole duration, or longer */
+        if (metadata->frameTime > metadata->animation.frames[metadata->frameIndex].duration) {
+            metadata->frameTime -= metadata->animation.frames[metadata->frameIndex].duration;
+            /* Increment the frame index to display the next one... */
+            metadata->frameIndex += 1;
+            /* ...unless the last frame was "last" in both senses */
+            if (metadata->frameIndex == metadata->animation.framesLength)
+                metadata->frameIndex = 0; /* Wrap around to the first frame */
+            /* Drawing only needs the GID of the frame's tile. Frames have local IDs within the tileset whose */
+            /* first GID is the animation tile's 'gid' so the frame's GID is their sum. */
+            tile->frameGid = tile->gid + metadata->animation.frames[metadata->frameIndex].id;
         }
     }
 }
 
+RAYTMX_DEC void UpdateTMXChunks(TmxMap* map, Rectangle area) {
+    if (map == NULL || map->tileWidth == 0 || map->tileHeight == 0)
+        return;
+
+    /* Every chunk within the area is marked with the new time and made resident if it isn't already */
+    map->chunkClock += 1;
+    UpdateTileLayerChunks(map, map->layers, map->layersLength, area);
+
+    /* Evict the chunks used least recently, never those just marked, until the map is back within its budget */
+    while (map->chunkMemoryUsed > map->chunkMemoryBudget) {
+        TmxTileChunk* leastRecent = FindLeastRecentChunk(map->layers, map->layersLength, map->chunkClock, NULL);
+        if (leastRecent == NULL) /* If every resident chunk is within the area */
+            break;
+        UnloadTileChunk(map, leastRecent);
+    }
+}
+
+RAYTMX_DEC uint32_t GetTMXTileLayerGid(const TmxMap* map, const TmxTileLayer* tileLayer, int32_t x, int32_t y) {
+    if (map == NULL || tileLayer == NULL)
+        return 0;
+
+    if (tileLayer->tiles != NULL) { /* If the layer has a single array of tiles, as with finite maps */
+        if (x < 0 || y < 0 || x >= (int32_t)map->width || y >= (int32_t)map->height)
+            return 0;
+        uint32_t index = ((uint32_t)y * map->width) + (uint32_t)x;
+        return index < tileLayer->tilesLength ? tileLayer->tiles[index] : 0;
+    }
+
+    uint32_t cursor = 0;
+    const TmxTileChunk* chunk = NextTileChunk(tileLayer, x, y, x, y, &cursor);
+    if (chunk == NULL || chunk->tiles == NULL) /* If there's no chunk here or its data couldn't be decoded */
+        return 0;
+    return chunk->tiles[((uint32_t)(y - chunk->y) * chunk->tilesStride) + (uint32_t)(x - chunk->x)];
+}
+
 /**
  * Helper function that creates a TmxObject equivalent to the given rectangle.
  *
@@ -1192,7 +1602,8 @@ RAYTMX_DEC bool CheckCollisionTMXTileLayersRec(const TmxMap* map, const TmxLayer
         return false;
 
     /* Check the rectangle against objects associated with tiles in the layers for collisions */
-    return CheckCollisionTMXTileLayerObject(map, layers, layersLength, CreateRectangularTMXObject(rec), outputObject);
+    RaytmxCollisionQuery query = CreateCollisionQuery(CreateRectangularTMXObject(rec));
+    return CheckCollisionTMXTileLayerObject(map, layers, layersLength, &query, outputObject);
 }
 
 /**
@@ -1225,8 +1636,8 @@ RAYTMX_DEC bool CheckCollisionTMXTileLayersCircle(const TmxMap* map, const TmxLa
         return false;
 
     /* Check the circle against objects associated with tiles in the layers for collisions */
-    return CheckCollisionTMXTileLayerObject(map, layers, layersLength, CreateCircularTMXObject(center, radius),
-        outputObject);
+    RaytmxCollisionQuery query = CreateCollisionQuery(CreateCircularTMXObject(center, radius));
+    return CheckCollisionTMXTileLayerObject(map, layers, layersLength, &query, outputObject);
 }
 
 /**
@@ -1254,7 +1665,97 @@ RAYTMX_DEC bool CheckCollisionTMXTileLayersPoint(const TmxMap* map, const TmxLay
         return false;
 
     /* Check the point against objects associated with tiles in the layers for collisions */
-    return CheckCollisionTMXTileLayerObject(map, layers, layersLength, CreatePointTMXObject(point), outputObject);
+    RaytmxCollisionQuery query = CreateCollisionQuery(CreatePointTMXObject(point));
+    return CheckCollisionTMXTileLayerObject(map, layers, layersLength, &query, outputObject);
+}
+
+RAYTMX_DEC uint32_t CheckCollisionTMXTileLayersRecs(const TmxMap* map, const TmxLayer* layers, uint32_t layersLength,
+        const Rectangle* recs, uint32_t recsLength, uint32_t* results) {
+    if (results == NULL)
+        return 0;
+    memset(results, 0, sizeof(uint32_t) * ((recsLength + 31) / 32));
+    if (map == NULL || map->gidsToCollision == NULL || layers == NULL || layersLength == 0 || recs == NULL ||
+            recsLength == 0)
+        return 0;
+
+    /* Find the tile layers, including those within groups, once for every rectangle. Up to 16 fit on the stack. */
+    const TmxTileLayer* localTileLayers[16];
+    const TmxTileLayer** tileLayers = localTileLayers;
+    uint32_t tileLayersLength = CollectTileLayers(layers, layersLength, tileLayers, 16);
+    if (tileLayersLength > 16) {
+        tileLayers = (const TmxTileLayer**)MemAlloc(sizeof(TmxTileLayer*) * tileLayersLength);
+        CollectTileLayers(layers, layersLength, tileLayers, tileLayersLength);
+    }
+
+    /* Reuse one query, only moving and resizing it, rather than creating a new one for every rectangle */
+    RaytmxCollisionQuery query = CreateCollisionQuery(CreateRectangularTMXObject((Rectangle){0.0f}));
+    uint32_t collisionsLength = 0;
+    for (uint32_t i = 0; i < recsLength; i++) {
+        query.aabb = recs[i];
+        query.object.x = (double)recs[i].x;
+        query.object.y = (double)recs[i].y;
+        query.object.width = (double)recs[i].width;
+        query.object.height = (double)recs[i].height;
+        query.object.aabb = recs[i];
+        for (uint32_t j = 0; j < tileLayersLength; j++) {
+            if (CheckCollisionTMXTileLayerCells(map, tileLayers[j], &query, NULL)) {
+                results[i / 32] |= 1u << (i % 32);
+                collisionsLength += 1;
+                break;
+            }
+        }
+    }
+
+    if (tileLayers != localTileLayers)
+        MemFree((void*)tileLayers);
+    return collisionsLength;
+}
+
+RAYTMX_DEC uint32_t CheckCollisionTMXTileLayersCircles(const TmxMap* map, const TmxLayer* layers,
+        uint32_t layersLength, const Vector2* centers, const float* radii, uint32_t circlesLength, uint32_t* results) {
+    if (results == NULL)
+        return 0;
+    memset(results, 0, sizeof(uint32_t) * ((circlesLength + 31) / 32));
+    if (map == NULL || map->gidsToCollision == NULL || layers == NULL || layersLength == 0 || centers == NULL ||
+            radii == NULL || circlesLength == 0)
+        return 0;
+
+    /* Find the tile layers, including those within groups, once for every circle. Up to 16 fit on the stack. */
+    const TmxTileLayer* localTileLayers[16];
+    const TmxTileLayer** tileLayers = localTileLayers;
+    uint32_t tileLayersLength = CollectTileLayers(layers, layersLength, tileLayers, 16);
+    if (tileLayersLength > 16) {
+        tileLayers = (const TmxTileLayer**)MemAlloc(sizeof(TmxTileLayer*) * tileLayersLength);
+        CollectTileLayers(layers, layersLength, tileLayers, tileLayersLength);
+    }
+
+    /* Reuse one query, only moving and resizing it, rather than creating a new one for every circle */
+    RaytmxCollisionQuery query = CreateCollisionQuery(CreateCircularTMXObject((Vector2){0.0f, 0.0f}, 0.0f));
+    uint32_t collisionsLength = 0;
+    for (uint32_t i = 0; i < circlesLength; i++) {
+        query.center = centers[i];
+        query.radius = radii[i];
+        query.aabb.x = centers[i].x - radii[i];
+        query.aabb.y = centers[i].y - radii[i];
+        query.aabb.width = 2.0f * radii[i];
+        query.aabb.height = 2.0f * radii[i];
+        query.object.x = (double)query.aabb.x;
+        query.object.y = (double)query.aabb.y;
+        query.object.width = (double)query.aabb.width;
+        query.object.height = (double)query.aabb.height;
+        query.object.aabb = query.aabb;
+        for (uint32_t j = 0; j < tileLayersLength; j++) {
+            if (CheckCollisionTMXTileLayerCells(map, tileLayers[j], &query, NULL)) {
+                results[i / 32] |= 1u << (i % 32);
+                collisionsLength += 1;
+                break;
+            }
+        }
+    }
+
+    if (tileLayers != localTileLayers)
+        MemFree((void*)tileLayers);
+    return collisionsLength;
 }
 
 /**
@@ -1313,193 +1814,1248 @@ RAYTMX_DEC bool CheckCollisionTMXLayersPoly(const TmxMap* map, const TmxLayer* l
         return false;
 
     /* Check the polygon against objects associated with tiles in the layers for collisions */
-    return CheckCollisionTMXTileLayerObject(map, layers, layersLength,
-        CreatePolygonTMXObject(points, pointCount, (Rectangle){0.0f}), outputObject);
+    RaytmxCollisionQuery query = CreateCollisionQuery(CreatePolygonTMXObject(points, pointCount, (Rectangle){0.0f}));
+    return CheckCollisionTMXTileLayerObject(map, layers, layersLength, &query, outputObject);
+}
+
+RAYTMX_DEC bool CheckCollisionTMXLayersPolyEx(const TmxMap* map, const TmxLayer* layers, uint32_t layersLength,
+        Vector2* points, int pointCount, Rectangle aabb, TmxObject* outputObject) {
+    if (map == NULL || layers == NULL || layersLength == 0 || points == NULL || pointCount < 3)
+        return false;
+
+    /* Check the polygon against objects associated with tiles in the layers for collisions */
+    RaytmxCollisionQuery query = CreateCollisionQuery(CreatePolygonTMXObject(points, pointCount, aabb));
+    return CheckCollisionTMXTileLayerObject(map, layers, layersLength, &query, outputObject);
+}
+
+RAYTMX_DEC bool CheckCollisionTMXObjectGroupRec(TmxObjectGroup group, Rectangle rec, TmxObject* outputObject) {
+    if (group.objectsLength == 0 || rec.width < 0.0f || rec.height < 0.0f)
+        return false; /* Early-out opportunity. These cases would always return false. */
+
+    /* Check the rectangle against TMX objects in the group for collisions */
+    return CheckCollisionTMXObjectGroupObject(group, CreateRectangularTMXObject(rec), outputObject);
 }
 
-RAYTMX_DEC bool CheckCollisionTMXLayersPolyEx(const TmxMap* map, const TmxLayer* layers, uint32_t layersLength,
-        Vector2* points, int pointCount, Rectangle aabb, TmxObject* outputObject) {
-    if (map == NULL || layers == NULL || layersLength == 0 || points == NULL || pointCount < 3)
-        return false;
+RAYTMX_DEC bool CheckCollisionTMXObjectGroupCircle(TmxObjectGroup group, Vector2 center, float radius,
+        TmxObject* outputObject) {
+    if (group.objectsLength == 0 || radius < 0.0f)
+        return false; /* Early-out opportunity. These cases would always return false. */
+
+    /* Check the circle against TMX objects in the group for collisions */
+    return CheckCollisionTMXObjectGroupObject(group, CreateCircularTMXObject(center, radius), outputObject);
+}
+
+RAYTMX_DEC bool CheckCollisionTMXObjectGroupPoint(TmxObjectGroup group, Vector2 point, TmxObject* outputObject) {
+    if (group.objectsLength == 0)
+        return false; /* Early-out opportunity. This case would always return false. */
+
+    /* Check the point against TMX objects in the group for collisions */
+    return CheckCollisionTMXObjectGroupObject(group, CreatePointTMXObject(point), outputObject);
+}
+
+RAYTMX_DEC bool CheckCollisionTMXObjectGroupPoly(TmxObjectGroup group, Vector2* points, int pointCount,
+        TmxObject* outputObject) {
+    if (group.objectsLength == 0 || points == NULL || pointCount < 3)
+        return false; /* Early-out opportunity. These cases would always return false. */
+
+    /* Check the polygon TMX object against other TMX objects in the group for collisions */
+    return CheckCollisionTMXObjectGroupObject(group, CreatePolygonTMXObject(points, pointCount, (Rectangle){0.0f}),
+        outputObject);
+}
+
+RAYTMX_DEC bool CheckCollisionTMXObjectGroupPolyEx(TmxObjectGroup group, Vector2* points, int pointCount,
+        Rectangle aabb, TmxObject* outputObject) {
+    if (group.objectsLength == 0 || points == NULL || pointCount < 3)
+        return false; /* Early-out opportunity. These cases would always return false. */
+
+    /* Check the polygon TMX object against other TMX objects in the group for collisions */
+    return CheckCollisionTMXObjectGroupObject(group, CreatePolygonTMXObject(points, pointCount, aabb), outputObject);
+}
+
+static LoadTextureCallback loadTextureOverride = NULL;
+
+RAYTMX_DEC void SetLoadTextureTMX(LoadTextureCallback callback) {
+    loadTextureOverride = callback;
+}
+
+static int tmxLogFlags = 0;
+
+RAYTMX_DEC void TraceLogTMX(int logLevel, const TmxMap* map) {
+    if (map == NULL)
+        return;
+
+    switch (map->orientation) {
+    case ORIENTATION_NONE: TraceLog(logLevel, "orientation: none"); break;
+    case ORIENTATION_ORTHOGONAL: TraceLog(logLevel, "orientation: orthogonal"); break;
+    case ORIENTATION_ISOMETRIC: TraceLog(logLevel, "orientation: isometric"); break;
+    case ORIENTATION_STAGGERED: TraceLog(logLevel, "orientation: staggered"); break;
+    case ORIENTATION_HEXAGONAL: TraceLog(logLevel, "orientation: hexagonal"); break;
+    }
+
+    switch (map->renderOrder) {
+    case RENDER_ORDER_RIGHT_DOWN: TraceLog(logLevel, "render order: right-down"); break;
+    case RENDER_ORDER_RIGHT_UP: TraceLog(logLevel, "render order: right-up"); break;
+    case RENDER_ORDER_LEFT_DOWN: TraceLog(logLevel, "render order: left-down"); break;
+    case RENDER_ORDER_LEFT_UP: TraceLog(logLevel, "render order: left-up"); break;
+    }
+
+    TraceLog(logLevel, "width: %u tiles", map->width);
+    TraceLog(logLevel, "height: %u tiles", map->height);
+    TraceLog(logLevel, "tile width: %u pixels", map->tileWidth);
+    TraceLog(logLevel, "tile height: %u pixels", map->tileHeight);
+    if (map->parallaxOriginX != 0)
+        TraceLog(logLevel, "parallax origin X: %d pixels", map->parallaxOriginX);
+    if (map->parallaxOriginY != 0)
+        TraceLog(logLevel, "parallax origin Y: %d pixels", map->parallaxOriginY);
+    if (map->hasBackgroundColor)
+        TraceLog(logLevel, "background color: 0x%08X", map->backgroundColor);
+
+    TraceLogTMXTilesets(logLevel, map->orientation, map->tilesets, map->tilesetsLength, 0);
+    TraceLogTMXProperties(logLevel, map->properties, map->propertiesLength, 0);
+    TraceLogTMXLayers(logLevel, map->layers, map->layersLength, 0);
+}
+
+RAYTMX_DEC void SetTraceLogFlagsTMX(int logFlags) {
+    tmxLogFlags = logFlags;
+}
+
+/**********************************************************************************************************************/
+/* Private implementation.                                                                                            */
+
+/* Parses a TMX document and builds its map model, minus the textures and the GID tables that depend on them. The */
+/* textures are returned as requests, each pointing at the image within the map it's for. */
+TmxMap* LoadTMXDocument(const char* fileName, RaytmxTextureRequestNode** textureRequestsRoot) {
+    RaytmxState raytmxState[1];
+    memset(raytmxState, 0, sizeof(RaytmxState)); /* Initialize all values to zero, NULL, or an equivalent enum value */
+    raytmxState->format = FORMAT_TMX;
+
+    /* Initialize the map object */
+    TmxMap* map = (TmxMap*)MemAllocZero(sizeof(TmxMap));
+
+    /* Do format-agnostic parsing of the document. The state object will be populated with raytmx's models of the */
+    /* equivalent TMX, TSX, and/or TX elements. */
+    ParseDocument(raytmxState, fileName);
+    if (!raytmxState->isSuccess) {
+        FreeState(raytmxState);
+        UnloadTMX(map);
+        return NULL;
+    }
+
+    /* Parsing only recorded the layers' data and external tilesets. Decode and load them now, in parallel. */
+    RunLoadJobs(raytmxState);
+
+    /* Copy some top-level map properties */
+    map->fileName = (char*)MemAllocZero((unsigned int)strlen(fileName) + 1);
+    StringCopy(map->fileName, GetFileName(fileName));
+    map->orientation = raytmxState->mapOrientation;
+    map->renderOrder = raytmxState->mapRenderOrder;
+    map->isInfinite = raytmxState->mapIsInfinite;
+    map->width = raytmxState->mapWidth;
+    map->height = raytmxState->mapHeight;
+    map->tileWidth = raytmxState->mapTileWidth;
+    map->tileHeight = raytmxState->mapTileHeight;
+    map->backgroundColor = raytmxState->mapBackgroundColor;
+    map->parallaxOriginX = raytmxState->mapParallaxOriginX;
+    map->parallaxOriginY = raytmxState->mapParallaxOriginY;
+    map->hasBackgroundColor = raytmxState->mapHasBackgroundColor;
+    map->chunkMemoryBudget = RAYTMX_CHUNK_MEMORY_BUDGET;
+
+    if (raytmxState->tilesetsRoot != NULL) { /* If there is at least one tileset */
+        /* Allocate the array of tilesets and zeroize every index */
+        TmxTileset* tilesets = (TmxTileset*)MemAllocZero(sizeof(TmxTileset) * raytmxState->tilesetsLength);
+        /* Copy the TmxTileset pointers into the array */
+        RaytmxTilesetNode* tilesetIterator = raytmxState->tilesetsRoot;
+        for (uint32_t i = 0; tilesetIterator != NULL; i++) {
+            TmxTileset tileset = tilesetIterator->tileset;
+            if (tileset.hasImage) /* If the tileset has a shared image and implicitly defines tiles */
+                tileset.lastGid = tileset.firstGid + tileset.tileCount - 1;
+            else if (tileset.tilesLength > 0) /* If the tileset is a "collection of images" with explicit tiles */
+                tileset.lastGid = tileset.firstGid + tileset.tiles[tileset.tilesLength - 1].id - 1;
+            tilesets[i] = tileset;
+            tilesetIterator = tilesetIterator->next;
+        }
+        /* Add the tilesets array to the map */
+        map->tilesets = tilesets;
+        map->tilesetsLength = raytmxState->tilesetsLength;
+    } else
+        TraceLog(LOG_WARNING, "RAYTMX: The map does not contain any tilesets");
+
+    if (raytmxState->layersRoot != NULL) { /* If there is at least one layer within the map */
+        /* Due to the existence of <group> layers, layers can have children of multiple generations. To form the */
+        /* resulting tree-like structure, recursion is used. */
+        AppendLayerTo(map, NULL, raytmxState->layersRoot, raytmxState->layersLength);
+    } else
+        TraceLog(LOG_WARNING, "RAYTMX: The map does not contain any layers");
+
+    /* Now that the images are where they'll stay, point the texture requests at them */
+    *textureRequestsRoot = FindRequestedImages(map, raytmxState->textureRequestsRoot);
+    raytmxState->textureRequestsRoot = NULL;
+    raytmxState->textureRequestsTail = NULL;
+
+    /* Free the linked lists and zeroize related values */
+    FreeState(raytmxState);
+
+    return map;
+}
+
+/* Does the part of LoadTMXAsync() that doesn't need the main thread: everything but uploading textures */
+void* RunAsyncLoad(void* asyncLoad) {
+    TmxAsyncLoad* load = (TmxAsyncLoad*)asyncLoad;
+    RaytmxTextureRequestNode* textureRequestsRoot = NULL;
+    TmxMap* map = LoadTMXDocument(load->fileName, &textureRequestsRoot);
+
+    /* Decode the images now so the main thread only has to upload them. This is skipped when the application */
+    /* loads textures itself and for images that are already in VRAM or already decoded for another request. */
+    for (RaytmxTextureRequestNode* request = textureRequestsRoot; request != NULL && loadTextureOverride == NULL;
+            request = request->next) {
+        bool isDuplicate = false;
+        for (RaytmxTextureRequestNode* other = textureRequestsRoot; other != request && !isDuplicate;
+                other = other->next)
+            isDuplicate = strcmp(other->fullPath, request->fullPath) == 0;
+        if (!isDuplicate && !IsTextureCached(request->fullPath))
+            request->decodedImage = LoadImage(request->fullPath);
+    }
+
+#ifdef RAYTMX_THREADS
+    pthread_mutex_lock(&load->mutex);
+#endif
+    load->map = map;
+    load->textureRequestsRoot = textureRequestsRoot;
+    load->isDocumentLoaded = true;
+#ifdef RAYTMX_THREADS
+    pthread_mutex_unlock(&load->mutex);
+#endif
+    return NULL;
+}
+
+RaytmxExternalTileset LoadTSX(const char* fileName) {
+    RaytmxState raytmxState[1];
+    memset(raytmxState, 0, sizeof(RaytmxState)); /* Initialize all values to zero, NULL, or an equivalent enum value */
+    raytmxState->format = FORMAT_TSX;
+
+    /* Initialize an external tileset object */
+    RaytmxExternalTileset externalTileset;
+    memset(&externalTileset, 0, sizeof(RaytmxExternalTileset));
+
+    /* Do format-agnostic parsing of the document. The state object will be populated with raytmx's models of the */
+    /* equivalent TMX, TSX, and/or TX elements. */
+    ParseDocument(raytmxState, fileName);
+    if (!raytmxState->isSuccess)
+        return externalTileset; /* Will have 'isSuccess' set to false to indicate a failure */
+
+    if (raytmxState->tilesetsRoot != NULL) { /* If there is at least one tileset */
+        /* Copy the root tileset so it can be returned */
+        externalTileset.tileset = raytmxState->tilesetsRoot->tileset;
+        externalTileset.isSuccess = true;
+        /* TSX files should have only one tileset so any others will be freed/unloaded immediately */
+        RaytmxTilesetNode* tilesetIterator = raytmxState->tilesetsRoot->next;
+        while (tilesetIterator != NULL) {
+            DiscardTextureRequests(raytmxState, &tilesetIterator->tileset);
+            FreeTileset(tilesetIterator->tileset);
+            tilesetIterator = tilesetIterator->next;
+        }
+        /* Hand the textures over to whoever is merging the tileset into their map */
+        externalTileset.textureRequestsRoot = raytmxState->textureRequestsRoot;
+        raytmxState->textureRequestsRoot = NULL;
+        raytmxState->textureRequestsTail = NULL;
+    } else
+        TraceLog(LOG_WARNING, "RAYTMX: TSX file (external tileset) \"%s\" does not contain any tilesets", fileName);
+
+    /* Free the linked lists and zeroize related values */
+    FreeState(raytmxState);
+
+    return externalTileset;
+}
+
+RaytmxObjectTemplate LoadTX(const char* fileName) {
+    RaytmxState raytmxState[1];
+    memset(raytmxState, 0, sizeof(RaytmxState)); /* Initialize all values to zero, NULL, or an equivalent enum value */
+    raytmxState->format = FORMAT_TX;
+
+    /* Initialize an object template object */
+    RaytmxObjectTemplate objectTemplate;
+    memset(&objectTemplate, 0, sizeof(RaytmxObjectTemplate));
+
+    /* Do format-agnostic parsing of the document. The state object will be populated with raytmx's models of the */
+    /* equivalent TMX, TSX, and/or TX elements. */
+    ParseDocument(raytmxState, fileName);
+    if (!raytmxState->isSuccess)
+        return objectTemplate; /* Will have 'isSuccess' set to false to indicate a failure */
+
+    if (raytmxState->objectsRoot != NULL) { /* If there is at least one object */
+        /* Copy the root object so it can be returned */
+        objectTemplate.object = raytmxState->objectsRoot->object;
+        objectTemplate.isSuccess = true;
+        /* TX files should have only one object so any others will be freed/unloaded immediately */
+        RaytmxObjectNode* objectIterator = raytmxState->objectsRoot->next;
+        while (objectIterator != NULL) {
+            FreeObject(objectIterator->object);
+            objectIterator = objectIterator->next;
+        }
+    } else
+        TraceLog(LOG_WARNING, "RAYTMX: TX file (object template) \"%s\" does not contain any objects", fileName);
+
+    if (raytmxState->tilesetsRoot != NULL) { /* If there is at least one tileset */
+        /* Object templates may have a tileset. This is for cases where the object references a tile (i.e. its 'gid' */
+        /* attribute is set).  Copy the root tileset so it can be returned */
+        objectTemplate.tileset = raytmxState->tilesetsRoot->tileset;
+        objectTemplate.hasTileset = true;
+        /* TX files should have at most one tileset so any others will be freed/unloaded immediately */
+        RaytmxTilesetNode* tilesetsIterator = raytmxState->tilesetsRoot->next;
+        while (tilesetsIterator != NULL) {
+            DiscardTextureRequests(raytmxState, &tilesetsIterator->tileset);
+            FreeTileset(tilesetsIterator->tileset);
+            tilesetsIterator = tilesetsIterator->next;
+        }
+        /* Hand the textures over to the document using the template */
+        objectTemplate.textureRequestsRoot = raytmxState->textureRequestsRoot;
+        raytmxState->textureRequestsRoot = NULL;
+        raytmxState->textureRequestsTail = NULL;
+    }
+
+    /* Free the linked lists and zeroize related values */
+    FreeState(raytmxState);
+
+    return objectTemplate;
+}
+
+/* Creates the map's arrays that map GIDs to the information needed to draw, animate, and collide with tiles */
+void BuildGidsToTiles(TmxMap* map) {
+    uint32_t gidsToTilesLength = 0; /* Can also be seen as the last GID */
+    for (uint32_t i = 0; i < map->tilesetsLength; i++) {
+        if (gidsToTilesLength < map->tilesets[i].lastGid + 1)
+            gidsToTilesLength = map->tilesets[i].lastGid + 1; /* GIDs start at 1 so the length is the last GID + 1 */
+    }
+    if (gidsToTilesLength <= 1) /* If there are no tilesets or none of them have tiles */
+        return;
+
+    TmxTile* gidsToTiles = (TmxTile*)MemAllocZero(sizeof(TmxTile) * gidsToTilesLength);
+    TmxTileMetadata* gidsToTileMetadata = (TmxTileMetadata*)MemAllocZero(sizeof(TmxTileMetadata) *
+        gidsToTilesLength);
+
+    for (uint32_t i = 0; i < map->tilesetsLength; i++) {
+        TmxTileset* tileset = &map->tilesets[i];
+        if (tileset->hasImage) { /* If the tileset has a shared image (i.e. not a "collection of images") */
+            /* Whereas most tiles in a tile layer are implicit, some may have information given directly, like */
+            /* animation frames or sub-rectangle values, as well as less relevant information. Index those explicit */
+            /* tiles by their local IDs so each implicit tile can find its explicit counterpart, if any, directly. */
+            TmxTilesetTile** explicitTiles = NULL;
+            if (tileset->tilesLength > 0 && tileset->tileCount > 0) {
+                explicitTiles = (TmxTilesetTile**)MemAllocZero(sizeof(TmxTilesetTile*) * tileset->tileCount);
+                for (uint32_t j = 0; j < tileset->tilesLength; j++) {
+                    if (tileset->tiles[j].id < tileset->tileCount && explicitTiles[tileset->tiles[j].id] == NULL)
+                        explicitTiles[tileset->tiles[j].id] = &tileset->tiles[j];
+                }
+            }
+
+            for (uint32_t id = 0; id < tileset->tileCount; id++) {
+                uint32_t gid = id + tileset->firstGid, x = id % tileset->columns, y = id/ tileset->columns;
+                bool hasExplicitSourceRect = false;
+                TmxTile* tile = &gidsToTiles[gid];
+                tile->gid = gid;
+
+                TmxTilesetTile* tilesetTile = explicitTiles != NULL ? explicitTiles[id] : NULL;
+                if (tilesetTile != NULL) { /* If this tileset tile has explicitly-defined information */
+                    /* Typical tiles are implicit since everything that must be known about them can be inferred */
+                    /* from knowing the dimensions the tileset's image, dimensions of tiles, and the (right-down) order */
+                    /* of tiles within the tilest's image. However, tiles can have additional, non-inferable */
+                    /* information. This is particularly true for animations. */
+                    if (tilesetTile->hasAnimation && tilesetTile->animation.framesLength > 0) {
+                        /* If the tile is meta, pointing to other tiles */
+                        tile->hasAnimation = true;
+                        gidsToTileMetadata[gid].animation = tilesetTile->animation;
+                        /* 'gid' is slightly repurposed for animations in that it's assigned with the tileset's */
+                        /* first GID rather than the tiles'. This is done because frames use local IDs and the */
+                        /* tileset's first GID is needed to get the frame's GID. */
+                        tile->gid = tileset->firstGid;
+                        tile->frameGid = tileset->firstGid + tilesetTile->animation.frames[0].id;
+                    } else if (tilesetTile->x != 0 || tilesetTile->y != 0 || tilesetTile->width != 0 ||
+                            tilesetTile->height != 0) {
+                        /* This tile directly tells us the area within the tileset's image to use when drawing, */
+                        /* overriding the implicit dimensions derived from the map's 'tilewidth' and 'tileheight' */
+                        /* attributes. */
+                        hasExplicitSourceRect = true;
+                        tile->sourceRect.x = (float)tilesetTile->x;
+                        tile->sourceRect.y = (float)tilesetTile->y;
+                        tile->sourceRect.width = (float)tilesetTile->width;
+                        tile->sourceRect.height = (float)tilesetTile->height;
+                    }
+
+                    /* Tiles may have child object groups. These objects are a form of collision information. The */
+                    /* object group may be empty or may have objects. A simple assignment covers both. */
+                    gidsToTileMetadata[gid].objectGroup = tilesetTile->objectGroup;
+                }
+
+                if (!tile->hasAnimation) { /* If the tile is of the typical, static variety */
+                    if (!hasExplicitSourceRect) { /* If that section was not explicitly defined */
+                        /* Calculate the area within the texture to be drawn from contextual information */
+                        tile->sourceRect.x = (float)(tileset->margin + (x * tileset->tileWidth) +
+                            (x * tileset->spacing));
+                        tile->sourceRect.y = (float)(tileset->margin + (y * tileset->tileHeight) +
+                            (y * tileset->spacing));
+                        tile->sourceRect.width = (float)tileset->tileWidth;
+                        tile->sourceRect.height = (float)tileset->tileHeight;
+                    }
+                    tile->texture = tileset->image.texture;
+                    tile->offset.x = (float)tileset->tileOffsetX;
+                    tile->offset.y = (float)tileset->tileOffsetY;
+                }
+            }
+
+            if (explicitTiles != NULL)
+                MemFree(explicitTiles);
+        } else { /* If the tileset is a collection of images where each tile has its own image */
+            for (uint32_t j = 0; j < tileset->tilesLength; j++) {
+                TmxTilesetTile tilesetTile = tileset->tiles[j];
+                if (!tilesetTile.hasImage) {
+                    TraceLog(LOG_WARNING, "RAYTMX: Skipping tile %d of image collection tileset \"%s\" because it "
+                        "has no image", tilesetTile.id, tileset->name);
+                    continue;
+                }
+
+                int32_t gid = tileset->firstGid + tilesetTile.id;
+                TmxTile* tile = &gidsToTiles[gid];
+                tile->gid = gid;
+                tile->sourceRect.x = (float)tilesetTile.x; /* Defaults to and probably is zero */
+                tile->sourceRect.y = (float)tilesetTile.y; /* Defaults to and probably is zero */
+                if (tilesetTile.width != tilesetTile.image.width)
+                    tile->sourceRect.width = (float)tilesetTile.width;
+                else
+                    tile->sourceRect.width = (float)tilesetTile.image.width;
+                if (tilesetTile.height != tilesetTile.image.height)
+                    tile->sourceRect.height = (float)tilesetTile.height;
+                else
+                    tile->sourceRect.height = (float)tilesetTile.image.height;
+                tile->texture = tilesetTile.image.texture;
+                gidsToTileMetadata[gid].objectGroup = tilesetTile.objectGroup;
+            }
+        }
+    }
+
+    /* List the animated tiles so AnimateTMX() can skip straight to them */
+    uint32_t animatedGidsLength = 0;
+    for (uint32_t gid = 1; gid < gidsToTilesLength; gid++) {
+        if (gidsToTiles[gid].gid > 0 && gidsToTiles[gid].hasAnimation)
+            animatedGidsLength += 1;
+    }
+    if (animatedGidsLength > 0) {
+        map->animatedGids = (uint32_t*)MemAlloc(sizeof(uint32_t) * animatedGidsLength);
+        for (uint32_t gid = 1, j = 0; gid < gidsToTilesLength; gid++) {
+            if (gidsToTiles[gid].gid > 0 && gidsToTiles[gid].hasAnimation)
+                map->animatedGids[j++] = gid;
+        }
+    }
+    map->animatedGidsLength = animatedGidsLength;
+
+    map->gidsToTiles = gidsToTiles;
+    map->gidsToTileMetadata = gidsToTileMetadata;
+    map->gidsToTilesLength = gidsToTilesLength;
+
+    /* With each tile's object group in place, flatten them into the shapes used for collision checks */
+    BuildTileCollisionShapes(map);
+}
+
+/* Splits each tile layer of a finite map into chunks referring to the layer's array of GIDs, builds the collision */
+/* bitmap of every chunk, finite or infinite, then, if 'makeResident' is true, makes the chunks of */
+/* finite maps resident until the map's budget is reached. Meshes are uploaded to VRAM so this must then be called on */
+/* the thread owning the graphics context. */
+void BuildTileLayerChunks(TmxMap* map, TmxLayer* layers, uint32_t layersLength, bool makeResident) {
+    for (uint32_t i = 0; i < layersLength; i++) {
+        TmxLayer* layer = &layers[i];
+        if (layer->type == LAYER_TYPE_GROUP) {
+            BuildTileLayerChunks(map, layer->layers, layer->layersLength, makeResident);
+            continue;
+        }
+        if (layer->type != LAYER_TYPE_TILE_LAYER)
+            continue;
+        TmxTileLayer* tileLayer = &layer->exact.tileLayer;
+
+        if (tileLayer->chunks == NULL && tileLayer->tiles != NULL && map->width > 0 && map->height > 0) {
+            /* Chunks of finite maps point into the layer's array so it's padded to cover the whole map first */
+            uint32_t mapTilesLength = map->width * map->height;
+            if (tileLayer->tilesLength < mapTilesLength) {
+                tileLayer->tiles = (uint32_t*)MemRealloc(tileLayer->tiles,
+                    (unsigned int)(sizeof(uint32_t) * mapTilesLength));
+                memset(tileLayer->tiles + tileLayer->tilesLength, 0,
+                    sizeof(uint32_t) * (mapTilesLength - tileLayer->tilesLength));
+                tileLayer->tilesLength = mapTilesLength;
+            }
+
+            uint32_t chunksWide = (map->width + RAYTMX_CHUNK_WIDTH - 1) / RAYTMX_CHUNK_WIDTH;
+            uint32_t chunksHigh = (map->height + RAYTMX_CHUNK_HEIGHT - 1) / RAYTMX_CHUNK_HEIGHT;
+            tileLayer->chunksLength = chunksWide * chunksHigh;
+            tileLayer->chunks = (TmxTileChunk*)MemAllocZero(sizeof(TmxTileChunk) * tileLayer->chunksLength);
+            for (uint32_t chunkY = 0; chunkY < chunksHigh; chunkY++) {
+                for (uint32_t chunkX = 0; chunkX < chunksWide; chunkX++) {
+                    TmxTileChunk* chunk = &tileLayer->chunks[(chunkY * chunksWide) + chunkX];
+                    uint32_t x = chunkX * RAYTMX_CHUNK_WIDTH, y = chunkY * RAYTMX_CHUNK_HEIGHT;
+                    chunk->x = (int32_t)x;
+                    chunk->y = (int32_t)y;
+                    chunk->width = map->width - x < RAYTMX_CHUNK_WIDTH ? map->width - x : RAYTMX_CHUNK_WIDTH;
+                    chunk->height = map->height - y < RAYTMX_CHUNK_HEIGHT ? map->height - y : RAYTMX_CHUNK_HEIGHT;
+                    chunk->tiles = tileLayer->tiles + (y * map->width) + x;
+                    chunk->tilesStride = map->width;
+                }
+            }
+        }
+
+        /* Bitmaps live as long as the tiles do, rather than being built and freed with the meshes */
+        for (uint32_t j = 0; j < tileLayer->chunksLength; j++) {
+            if (tileLayer->chunks[j].tiles != NULL && tileLayer->chunks[j].collisionBits == NULL)
+                BuildTileChunkCollision(map, &tileLayer->chunks[j]);
+        }
+        BuildTileChunkGrid(tileLayer);
+
+        /* Finite maps are usually small enough to be entirely resident. Otherwise, UpdateTMXChunks() takes over. */
+        if (makeResident && tileLayer->tiles != NULL) {
+            for (uint32_t j = 0; j < tileLayer->chunksLength && map->chunkMemoryUsed < map->chunkMemoryBudget; j++)
+                LoadTileChunk(map, &tileLayer->chunks[j]);
+        }
+    }
+}
+
+/* Builds a grid with a cell per chunk, sized to fit the largest chunk, so the chunks within an area can be found */
+/* without searching. Chunks are normally of the same size and aligned to one another, as Tiled saves them, but if */
+/* they aren't or the grid would be mostly empty, no grid is built and chunks are searched one by one instead. */
+void BuildTileChunkGrid(TmxTileLayer* tileLayer) {
+    if (tileLayer->chunksLength == 0)
+        return;
+
+    int32_t minX = tileLayer->chunks[0].x, minY = tileLayer->chunks[0].y, maxX = minX, maxY = minY;
+    uint32_t chunkWidth = 0, chunkHeight = 0;
+    for (uint32_t i = 0; i < tileLayer->chunksLength; i++) {
+        const TmxTileChunk* chunk = &tileLayer->chunks[i];
+        minX = chunk->x < minX ? chunk->x : minX;
+        minY = chunk->y < minY ? chunk->y : minY;
+        maxX = chunk->x > maxX ? chunk->x : maxX;
+        maxY = chunk->y > maxY ? chunk->y : maxY;
+        chunkWidth = chunk->width > chunkWidth ? chunk->width : chunkWidth;
+        chunkHeight = chunk->height > chunkHeight ? chunk->height : chunkHeight;
+    }
+    tileLayer->chunkWidth = chunkWidth;
+    tileLayer->chunkHeight = chunkHeight;
+    if (chunkWidth == 0 || chunkHeight == 0)
+        return;
+
+    uint32_t gridWidth = ((uint32_t)(maxX - minX) / chunkWidth) + 1;
+    uint32_t gridHeight = ((uint32_t)(maxY - minY) / chunkHeight) + 1;
+    if ((uint64_t)gridWidth * gridHeight > (uint64_t)tileLayer->chunksLength * 16) /* If mostly empty */
+        return;
+
+    uint32_t* chunkGrid = (uint32_t*)MemAllocZero(sizeof(uint32_t) * gridWidth * gridHeight);
+    for (uint32_t i = 0; i < tileLayer->chunksLength; i++) {
+        const TmxTileChunk* chunk = &tileLayer->chunks[i];
+        uint32_t cellX = (uint32_t)(chunk->x - minX) / chunkWidth, cellY = (uint32_t)(chunk->y - minY) / chunkHeight;
+        uint32_t cell = (cellY * gridWidth) + cellX;
+        /* If the chunk isn't aligned to the grid or shares its cell, the grid can't be trusted to find it */
+        if ((uint32_t)(chunk->x - minX) % chunkWidth != 0 || (uint32_t)(chunk->y - minY) % chunkHeight != 0 ||
+                chunkGrid[cell] != 0) {
+            MemFree(chunkGrid);
+            return;
+        }
+        chunkGrid[cell] = i + 1;
+    }
+
+    tileLayer->chunkGrid = chunkGrid;
+    tileLayer->chunkGridX = minX;
+    tileLayer->chunkGridY = minY;
+    tileLayer->chunkGridWidth = gridWidth;
+    tileLayer->chunkGridHeight = gridHeight;
+}
+
+/* Decodes a <chunk>'s content into the chunk's array of GIDs the same way a <layer>'s <data> is decoded. The tiles */
+/* are kept for as long as the map is loaded, resident or not, so collisions never depend on what's in view. */
+bool DecodeTileChunk(const TmxTileLayer* tileLayer, const char* layerName, TmxTileChunk* chunk, const char* content,
+        size_t contentLength) {
+    uint32_t tilesLength = chunk->width * chunk->height;
+    TmxTileLayer decoded;
+    memset(&decoded, 0, sizeof(TmxTileLayer));
+    decoded.width = chunk->width;
+    decoded.height = chunk->height;
+    decoded.encoding = tileLayer->encoding;
+    decoded.compression = tileLayer->compression;
+    if (tilesLength > 0)
+        DecodeTileLayerData(&decoded, layerName, content, contentLength);
+    if (decoded.tiles == NULL)
+        return false;
+
+    /* Short data is padded with empty tiles so every row of the chunk can be read */
+    if (decoded.tilesLength < tilesLength) {
+        decoded.tiles = (uint32_t*)MemRealloc(decoded.tiles, (unsigned int)(sizeof(uint32_t) * tilesLength));
+        memset(decoded.tiles + decoded.tilesLength, 0, sizeof(uint32_t) * (tilesLength - decoded.tilesLength));
+    }
+    chunk->tiles = decoded.tiles;
+    chunk->tilesStride = chunk->width;
+    return true;
+}
+
+/* Builds a chunk's bitmap of tiles with collision shapes so collision checks can skip tiles without any, 32 at a */
+/* time, without looking up their GIDs. No bitmap is allocated for chunks where no tile has any shapes. */
+void BuildTileChunkCollision(const TmxMap* map, TmxTileChunk* chunk) {
+    if (chunk->tiles == NULL || map->gidsToCollision == NULL)
+        return;
+
+    uint32_t wordsPerRow = (chunk->width + 31) / 32;
+    uint32_t* collisionBits = NULL;
+    for (uint32_t row = 0; row < chunk->height; row++) {
+        for (uint32_t column = 0; column < chunk->width; column++) {
+            uint32_t gid = GetGid(chunk->tiles[(row * chunk->tilesStride) + column], NULL, NULL, NULL, NULL);
+            if (gid >= map->gidsToTilesLength || map->gidsToCollision[gid].shapesLength == 0)
+                continue;
+            if (collisionBits == NULL)
+                collisionBits = (uint32_t*)MemAllocZero(sizeof(uint32_t) * wordsPerRow * chunk->height);
+            collisionBits[(row * wordsPerRow) + (column / 32)] |= 1u << (column % 32);
+        }
+    }
+    chunk->collisionBits = collisionBits;
+}
+
+/* Builds a chunk's meshes of its static tiles grouped by texture, and a list of its animated tiles. Vertices are in */
+/* layer space so every chunk of a layer is drawn with the same transform. */
+void BuildTileChunkBatches(const TmxMap* map, TmxTileChunk* chunk) {
+    /* Indices are 16-bit so each mesh holds at most 65536 vertices, or 16384 quads */
+    const uint32_t maxQuadsPerBatch = 65536 / 4;
+
+    chunk->bounds = (Rectangle){ 0.0f, 0.0f, 0.0f, 0.0f };
+    if (chunk->tiles == NULL || map->gidsToTilesLength == 0)
+        return;
+
+    /* First pass: count the animated tiles and, per distinct texture, the static tiles using it. Textures are */
+    /* identified by ID with each GID assigned a slot so the second pass doesn't need to search for them. */
+    Texture2D* textures = (Texture2D*)MemAlloc(sizeof(Texture2D) * map->gidsToTilesLength);
+    uint32_t* quadCounts = (uint32_t*)MemAllocZero(sizeof(uint32_t) * map->gidsToTilesLength);
+    uint32_t* gidSlots = (uint32_t*)MemAlloc(sizeof(uint32_t) * map->gidsToTilesLength);
+    for (uint32_t gid = 0; gid < map->gidsToTilesLength; gid++)
+        gidSlots[gid] = UINT32_MAX;
+    uint32_t texturesLength = 0, animatedTilesLength = 0;
+    for (uint32_t row = 0; row < chunk->height; row++) {
+        for (uint32_t column = 0; column < chunk->width; column++) {
+            uint32_t gid = GetGid(chunk->tiles[(row * chunk->tilesStride) + column], NULL, NULL, NULL, NULL);
+            if (gid == 0 || gid >= map->gidsToTilesLength || map->gidsToTiles[gid].gid == 0)
+                continue;
+            TmxTile tile = map->gidsToTiles[gid];
+            if (tile.hasAnimation) {
+                animatedTilesLength += 1;
+                continue;
+            }
+            if (tile.texture.id == 0) /* If the texture failed to load there's nothing to draw */
+                continue;
+            if (gidSlots[gid] == UINT32_MAX) { /* If this GID hasn't been seen yet, find or add its texture */
+                uint32_t slot = 0;
+                while (slot < texturesLength && textures[slot].id != tile.texture.id)
+                    slot += 1;
+                if (slot == texturesLength)
+                    textures[texturesLength++] = tile.texture;
+                gidSlots[gid] = slot;
+            }
+            quadCounts[gidSlots[gid]] += 1;
+        }
+    }
+
+    /* Allocate the batches, splitting textures with more tiles than a mesh can hold across several */
+    uint32_t* firstBatches = (uint32_t*)MemAlloc(sizeof(uint32_t) * (texturesLength + 1));
+    uint32_t batchesLength = 0;
+    for (uint32_t slot = 0; slot < texturesLength; slot++) {
+        firstBatches[slot] = batchesLength;
+        batchesLength += (quadCounts[slot] + maxQuadsPerBatch - 1) / maxQuadsPerBatch;
+    }
+    if (batchesLength > 0)
+        chunk->batches = (TmxTileBatch*)MemAllocZero(sizeof(TmxTileBatch) * batchesLength);
+    for (uint32_t slot = 0; slot < texturesLength; slot++) {
+        uint32_t remaining = quadCounts[slot];
+        for (uint32_t b = firstBatches[slot]; remaining > 0; b++) {
+            uint32_t quads = remaining < maxQuadsPerBatch ? remaining : maxQuadsPerBatch;
+            Mesh* mesh = &chunk->batches[b].mesh;
+            mesh->vertexCount = (int)quads * 4;
+            mesh->triangleCount = (int)quads * 2;
+            mesh->vertices = (float*)MemAlloc(sizeof(float) * 3 * quads * 4);
+            mesh->texcoords = (float*)MemAlloc(sizeof(float) * 2 * quads * 4);
+            mesh->indices = (unsigned short*)MemAlloc(sizeof(unsigned short) * 6 * quads);
+            chunk->batches[b].material = LoadMaterialDefault();
+            chunk->batches[b].material.maps[MATERIAL_MAP_DIFFUSE].texture = textures[slot];
+            remaining -= quads;
+        }
+        quadCounts[slot] = 0; /* Reused as the number of quads written so far */
+    }
+    if (animatedTilesLength > 0)
+        chunk->animatedTiles = (uint32_t*)MemAlloc(sizeof(uint32_t) * animatedTilesLength);
+
+    /* Second pass: write each static tile's quad into its texture's mesh in the map's render order, which is */
+    /* the order the GPU will draw them in. Flips are resolved now so drawing never has to look at them. */
+    bool isRowReversed = map->renderOrder == RENDER_ORDER_RIGHT_UP || map->renderOrder == RENDER_ORDER_LEFT_UP;
+    bool isColumnReversed = map->renderOrder == RENDER_ORDER_LEFT_DOWN || map->renderOrder == RENDER_ORDER_LEFT_UP;
+    float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    animatedTilesLength = 0;
+    for (uint32_t r = 0; r < chunk->height; r++) {
+        uint32_t row = isRowReversed ? chunk->height - 1 - r : r;
+        for (uint32_t c = 0; c < chunk->width; c++) {
+            uint32_t column = isColumnReversed ? chunk->width - 1 - c : c;
+            bool isFlippedHorizontally, isFlippedVertically, isFlippedDiagonally;
+            uint32_t gid = GetGid(chunk->tiles[(row * chunk->tilesStride) + column], &isFlippedHorizontally,
+                &isFlippedVertically, &isFlippedDiagonally, NULL);
+            if (gid == 0 || gid >= map->gidsToTilesLength || map->gidsToTiles[gid].gid == 0)
+                continue;
+            TmxTile tile = map->gidsToTiles[gid];
+            if (!tile.hasAnimation && gidSlots[gid] == UINT32_MAX)
+                continue;
+
+            /* Same placement as DrawTMXLayerTile(): larger tiles extend upward from the bottom-left */
+            Rectangle destRect;
+            destRect.x = (float)((chunk->x + (int32_t)column) * (int32_t)map->tileWidth) + tile.offset.x;
+            destRect.y = (float)((chunk->y + (int32_t)row) * (int32_t)map->tileHeight) + tile.offset.y +
+                map->tileHeight - tile.sourceRect.height;
+            destRect.width = tile.sourceRect.width;
+            destRect.height = tile.sourceRect.height;
+            minX = destRect.x < minX ? destRect.x : minX;
+            minY = destRect.y < minY ? destRect.y : minY;
+            maxX = destRect.x + destRect.width > maxX ? destRect.x + destRect.width : maxX;
+            maxY = destRect.y + destRect.height > maxY ? destRect.y + destRect.height : maxY;
+
+            if (tile.hasAnimation) {
+                chunk->animatedTiles[animatedTilesLength++] = (row * chunk->width) + column;
+                continue;
+            }
+
+            uint32_t slot = gidSlots[gid];
+            uint32_t quad = quadCounts[slot]++;
+            Mesh* mesh = &chunk->batches[firstBatches[slot] + (quad / maxQuadsPerBatch)].mesh;
+            quad %= maxQuadsPerBatch;
+
+            /* Top-left, bottom-left, bottom-right, top-right as with DrawTextureTile() */
+            Vector2 positions[4] = {
+                { destRect.x, destRect.y },
+                { destRect.x, destRect.y + destRect.height },
+                { destRect.x + destRect.width, destRect.y + destRect.height },
+                { destRect.x + destRect.width, destRect.y }
+            };
+            Vector2 texCoords[4];
+            GetTileTexCoords(tile.texture, tile.sourceRect, isFlippedHorizontally, isFlippedVertically,
+                isFlippedDiagonally, texCoords);
+            for (uint32_t k = 0; k < 4; k++) {
+                mesh->vertices[((quad * 4) + k) * 3 + 0] = positions[k].x;
+                mesh->vertices[((quad * 4) + k) * 3 + 1] = positions[k].y;
+                mesh->vertices[((quad * 4) + k) * 3 + 2] = 0.0f;
+                mesh->texcoords[((quad * 4) + k) * 2 + 0] = texCoords[k].x;
+                mesh->texcoords[((quad * 4) + k) * 2 + 1] = texCoords[k].y;
+            }
+            unsigned short firstVertex = (unsigned short)(quad * 4);
+            mesh->indices[(quad * 6) + 0] = firstVertex;
+            mesh->indices[(quad * 6) + 1] = firstVertex + 1;
+            mesh->indices[(quad * 6) + 2] = firstVertex + 2;
+            mesh->indices[(quad * 6) + 3] = firstVertex;
+            mesh->indices[(quad * 6) + 4] = firstVertex + 2;
+            mesh->indices[(quad * 6) + 5] = firstVertex + 3;
+        }
+    }
 
-    /* Check the polygon against objects associated with tiles in the layers for collisions */
-    return CheckCollisionTMXTileLayerObject(map, layers, layersLength,
-        CreatePolygonTMXObject(points, pointCount, aabb), outputObject);
+    for (uint32_t b = 0; b < batchesLength; b++)
+        UploadMesh(&chunk->batches[b].mesh, false);
+    chunk->batchesLength = batchesLength;
+    chunk->animatedTilesLength = animatedTilesLength;
+    if (minX <= maxX) /* If anything is drawn, the bounds cover it for culling */
+        chunk->bounds = (Rectangle){ minX, minY, maxX - minX, maxY - minY };
+
+    MemFree(textures);
+    MemFree(quadCounts);
+    MemFree(gidSlots);
+    MemFree(firstBatches);
 }
 
-RAYTMX_DEC bool CheckCollisionTMXObjectGroupRec(TmxObjectGroup group, Rectangle rec, TmxObject* outputObject) {
-    if (group.objectsLength == 0 || rec.width < 0.0f || rec.height < 0.0f)
-        return false; /* Early-out opportunity. These cases would always return false. */
+/* Makes a chunk resident by building its meshes. The memory this takes is added to the map's total. */
+void LoadTileChunk(TmxMap* map, TmxTileChunk* chunk) {
+    if (chunk->isResident || chunk->tiles == NULL)
+        return;
+    BuildTileChunkBatches(map, chunk);
 
-    /* Check the rectangle against TMX objects in the group for collisions */
-    return CheckCollisionTMXObjectGroupObject(group, CreateRectangularTMXObject(rec), outputObject);
+    /* Count the CPU-side copies of the meshes, matching what's in VRAM, and the list of animated tiles */
+    size_t residentBytes = sizeof(uint32_t) * chunk->animatedTilesLength;
+    for (uint32_t i = 0; i < chunk->batchesLength; i++) {
+        residentBytes += (size_t)chunk->batches[i].mesh.vertexCount * sizeof(float) * 5;
+        residentBytes += (size_t)chunk->batches[i].mesh.triangleCount * sizeof(unsigned short) * 3;
+    }
+    chunk->residentBytes = residentBytes;
+    chunk->isResident = true;
+    map->chunkMemoryUsed += residentBytes;
 }
 
-RAYTMX_DEC bool CheckCollisionTMXObjectGroupCircle(TmxObjectGroup group, Vector2 center, float radius,
-        TmxObject* outputObject) {
-    if (group.objectsLength == 0 || radius < 0.0f)
-        return false; /* Early-out opportunity. These cases would always return false. */
+/* Evicts a resident chunk by freeing its meshes. Its tiles and bitmap stay for drawing and collision checks. */
+void UnloadTileChunk(TmxMap* map, TmxTileChunk* chunk) {
+    if (!chunk->isResident)
+        return;
+    FreeTileChunkBatches(chunk);
+    map->chunkMemoryUsed -= chunk->residentBytes;
+    chunk->residentBytes = 0;
+    chunk->isResident = false;
+}
 
-    /* Check the circle against TMX objects in the group for collisions */
-    return CheckCollisionTMXObjectGroupObject(group, CreateCircularTMXObject(center, radius), outputObject);
+void FreeTileChunkBatches(TmxTileChunk* chunk) {
+    for (uint32_t i = 0; i < chunk->batchesLength; i++) {
+        UnloadMesh(chunk->batches[i].mesh);
+        /* Only the array of maps is freed. The shader and texture are raylib's default or owned by tilesets. */
+        MemFree(chunk->batches[i].material.maps);
+    }
+    if (chunk->batches != NULL)
+        MemFree(chunk->batches);
+    if (chunk->animatedTiles != NULL)
+        MemFree(chunk->animatedTiles);
+    chunk->batches = NULL;
+    chunk->batchesLength = 0;
+    chunk->animatedTiles = NULL;
+    chunk->animatedTilesLength = 0;
 }
 
-RAYTMX_DEC bool CheckCollisionTMXObjectGroupPoint(TmxObjectGroup group, Vector2 point, TmxObject* outputObject) {
-    if (group.objectsLength == 0)
-        return false; /* Early-out opportunity. This case would always return false. */
+/* Marks every chunk of the given layers within the area, in pixels relative to the layers, as used now and makes */
+/* those that aren't resident resident */
+void UpdateTileLayerChunks(TmxMap* map, TmxLayer* layers, uint32_t layersLength, Rectangle area) {
+    for (uint32_t i = 0; i < layersLength; i++) {
+        TmxLayer* layer = &layers[i];
+        /* Layers' offsets move their tiles so the area is moved the opposite way to be relative to them */
+        Rectangle layerArea = area;
+        layerArea.x -= (float)layer->offsetX;
+        layerArea.y -= (float)layer->offsetY;
+        if (layer->type == LAYER_TYPE_GROUP) {
+            UpdateTileLayerChunks(map, layer->layers, layer->layersLength, layerArea);
+            continue;
+        }
+        if (layer->type != LAYER_TYPE_TILE_LAYER || layer->exact.tileLayer.chunks == NULL)
+            continue;
+
+        int32_t fromX = (int32_t)floorf(layerArea.x / (float)map->tileWidth);
+        int32_t fromY = (int32_t)floorf(layerArea.y / (float)map->tileHeight);
+        int32_t toX = (int32_t)floorf((layerArea.x + layerArea.width) / (float)map->tileWidth);
+        int32_t toY = (int32_t)floorf((layerArea.y + layerArea.height) / (float)map->tileHeight);
+        uint32_t cursor = 0;
+        TmxTileChunk* chunk;
+        while ((chunk = NextTileChunk(&layer->exact.tileLayer, fromX, fromY, toX, toY, &cursor)) != NULL) {
+            chunk->lastUsed = map->chunkClock;
+            LoadTileChunk(map, chunk);
+        }
+    }
+}
 
-    /* Check the point against TMX objects in the group for collisions */
-    return CheckCollisionTMXObjectGroupObject(group, CreatePointTMXObject(point), outputObject);
+/* Finds the resident chunk, among the given layers and the given chunk, that was used longest ago but not now */
+TmxTileChunk* FindLeastRecentChunk(TmxLayer* layers, uint32_t layersLength, uint32_t clock, TmxTileChunk* leastRecent) {
+    for (uint32_t i = 0; i < layersLength; i++) {
+        TmxLayer* layer = &layers[i];
+        if (layer->type == LAYER_TYPE_GROUP) {
+            leastRecent = FindLeastRecentChunk(layer->layers, layer->layersLength, clock, leastRecent);
+            continue;
+        }
+        if (layer->type != LAYER_TYPE_TILE_LAYER)
+            continue;
+        for (uint32_t j = 0; j < layer->exact.tileLayer.chunksLength; j++) {
+            TmxTileChunk* chunk = &layer->exact.tileLayer.chunks[j];
+            /* Ages are compared rather than times so the clock wrapping around doesn't matter */
+            if (chunk->isResident && chunk->lastUsed != clock &&
+                    (leastRecent == NULL || clock - chunk->lastUsed > clock - leastRecent->lastUsed))
+                leastRecent = chunk;
+        }
+    }
+    return leastRecent;
 }
 
-RAYTMX_DEC bool CheckCollisionTMXObjectGroupPoly(TmxObjectGroup group, Vector2* points, int pointCount,
-        TmxObject* outputObject) {
-    if (group.objectsLength == 0 || points == NULL || pointCount < 3)
-        return false; /* Early-out opportunity. These cases would always return false. */
+/**
+ * Helper function for iterating through the chunks of a tile layer overlapping a range of tiles. Chunks are found
+ * through the layer's grid, if it has one, or otherwise by checking every chunk.
+ *
+ * @param tileLayer The tile layer whose chunks are to be iterated through.
+ * @param fromX X coordinate, in tiles, of the range's leftmost column.
+ * @param fromY Y coordinate, in tiles, of the range's topmost row.
+ * @param toX X coordinate, in tiles, of the range's rightmost column.
+ * @param toY Y coordinate, in tiles, of the range's bottommost row.
+ * @param cursor Position of the iteration. Must be zero for the first call and is updated by each call.
+ * @return The next chunk overlapping the range, or NULL if iteration is done.
+ */
+TmxTileChunk* NextTileChunk(const TmxTileLayer* tileLayer, int32_t fromX, int32_t fromY, int32_t toX, int32_t toY,
+        uint32_t* cursor) {
+    if (tileLayer->chunkGrid != NULL) {
+        /* Find the range of cells, within the grid, that the range of tiles overlaps */
+        int32_t fromCellX = FloorDivide(fromX - tileLayer->chunkGridX, (int32_t)tileLayer->chunkWidth);
+        int32_t fromCellY = FloorDivide(fromY - tileLayer->chunkGridY, (int32_t)tileLayer->chunkHeight);
+        int32_t toCellX = FloorDivide(toX - tileLayer->chunkGridX, (int32_t)tileLayer->chunkWidth);
+        int32_t toCellY = FloorDivide(toY - tileLayer->chunkGridY, (int32_t)tileLayer->chunkHeight);
+        if (toCellX < 0 || toCellY < 0 || fromCellX >= (int32_t)tileLayer->chunkGridWidth ||
+                fromCellY >= (int32_t)tileLayer->chunkGridHeight || fromCellX > toCellX || fromCellY > toCellY)
+            return NULL;
+        fromCellX = fromCellX < 0 ? 0 : fromCellX;
+        fromCellY = fromCellY < 0 ? 0 : fromCellY;
+        toCellX = toCellX >= (int32_t)tileLayer->chunkGridWidth ? (int32_t)tileLayer->chunkGridWidth - 1 : toCellX;
+        toCellY = toCellY >= (int32_t)tileLayer->chunkGridHeight ? (int32_t)tileLayer->chunkGridHeight - 1 : toCellY;
+
+        /* The cursor counts the cells visited, row by row */
+        uint32_t cellsWide = (uint32_t)(toCellX - fromCellX) + 1, cellsHigh = (uint32_t)(toCellY - fromCellY) + 1;
+        while (*cursor < cellsWide * cellsHigh) {
+            uint32_t cellX = (uint32_t)fromCellX + (*cursor % cellsWide);
+            uint32_t cellY = (uint32_t)fromCellY + (*cursor / cellsWide);
+            *cursor += 1;
+            uint32_t entry = tileLayer->chunkGrid[(cellY * tileLayer->chunkGridWidth) + cellX];
+            if (entry == 0) /* If the cell is empty */
+                continue;
+            TmxTileChunk* chunk = &tileLayer->chunks[entry - 1];
+            /* Chunks smaller than a cell may not reach the range */
+            if (chunk->x <= toX && chunk->x + (int32_t)chunk->width > fromX && chunk->y <= toY &&
+                    chunk->y + (int32_t)chunk->height > fromY)
+                return chunk;
+        }
+        return NULL;
+    }
 
-    /* Check the polygon TMX object against other TMX objects in the group for collisions */
-    return CheckCollisionTMXObjectGroupObject(group, CreatePolygonTMXObject(points, pointCount, (Rectangle){0.0f}),
-        outputObject);
+    /* The cursor is the index of the next chunk to check */
+    while (*cursor < tileLayer->chunksLength) {
+        TmxTileChunk* chunk = &tileLayer->chunks[*cursor];
+        *cursor += 1;
+        if (chunk->x <= toX && chunk->x + (int32_t)chunk->width > fromX && chunk->y <= toY &&
+                chunk->y + (int32_t)chunk->height > fromY)
+            return chunk;
+    }
+    return NULL;
 }
 
-RAYTMX_DEC bool CheckCollisionTMXObjectGroupPolyEx(TmxObjectGroup group, Vector2* points, int pointCount,
-        Rectangle aabb, TmxObject* outputObject) {
-    if (group.objectsLength == 0 || points == NULL || pointCount < 3)
-        return false; /* Early-out opportunity. These cases would always return false. */
+/* Flattens the collision information of every tile, its <objectgroup>, into typed shapes stored contiguously in the */
+/* map. Convex polygons get their vertices made relative to the tile and their edges' normals and projections */
+/* calculated once here rather than on every check. */
+void BuildTileCollisionShapes(TmxMap* map) {
+    /* Count the shapes, and the vertices of convex polygons, to allocate everything at once */
+    uint32_t shapesLength = 0, pointsLength = 0;
+    for (uint32_t gid = 1; gid < map->gidsToTilesLength; gid++) {
+        const TmxObjectGroup* objectGroup = &map->gidsToTileMetadata[gid].objectGroup;
+        shapesLength += objectGroup->objectsLength;
+        for (uint32_t i = 0; i < objectGroup->objectsLength; i++) {
+            const TmxObject* object = &objectGroup->objects[i];
+            if (object->type == OBJECT_TYPE_POLYGON && IsConvexPolygon(object->points, object->pointsLength))
+                pointsLength += object->pointsLength;
+        }
+    }
+    if (shapesLength == 0) /* If no tile has any collision information */
+        return; /* Leaving 'gidsToCollision' NULL lets collision checks exit immediately */
+
+    map->gidsToCollision = (TmxTileCollision*)MemAllocZero(sizeof(TmxTileCollision) * map->gidsToTilesLength);
+    map->collisionShapes = (TmxCollisionShape*)MemAllocZero(sizeof(TmxCollisionShape) * shapesLength);
+    if (pointsLength > 0) {
+        map->collisionPoints = (Vector2*)MemAlloc(sizeof(Vector2) * pointsLength);
+        map->collisionEdges = (TmxCollisionEdge*)MemAlloc(sizeof(TmxCollisionEdge) * pointsLength);
+    }
 
-    /* Check the polygon TMX object against other TMX objects in the group for collisions */
-    return CheckCollisionTMXObjectGroupObject(group, CreatePolygonTMXObject(points, pointCount, aabb), outputObject);
+    uint32_t shapesIndex = 0, pointsIndex = 0;
+    for (uint32_t gid = 1; gid < map->gidsToTilesLength; gid++) {
+        const TmxObjectGroup* objectGroup = &map->gidsToTileMetadata[gid].objectGroup;
+        TmxTileCollision* collision = &map->gidsToCollision[gid];
+        collision->shapesIndex = shapesIndex;
+        collision->shapesLength = objectGroup->objectsLength;
+        for (uint32_t i = 0; i < objectGroup->objectsLength; i++) {
+            const TmxObject* object = &objectGroup->objects[i];
+            TmxCollisionShape* shape = &map->collisionShapes[shapesIndex++];
+            shape->aabb = object->aabb;
+            shape->objectIndex = i;
+            switch (object->type) {
+            case OBJECT_TYPE_RECTANGLE:
+                shape->type = COLLISION_SHAPE_BOX;
+            break;
+            case OBJECT_TYPE_ELLIPSE:
+                if (object->width == object->height) {
+                    shape->type = COLLISION_SHAPE_CIRCLE;
+                    shape->radius = (float)object->width / 2.0f;
+                    shape->center = (Vector2){ (float)object->x + shape->radius, (float)object->y + shape->radius };
+                } else
+                    shape->type = COLLISION_SHAPE_BOX; /* Ellipses have always been treated as rectangles */
+            break;
+            case OBJECT_TYPE_POINT:
+                shape->type = COLLISION_SHAPE_POINT;
+                shape->center = (Vector2){ (float)object->x, (float)object->y };
+            break;
+            case OBJECT_TYPE_POLYGON:
+                if (IsConvexPolygon(object->points, object->pointsLength)) {
+                    shape->type = COLLISION_SHAPE_CONVEX_POLYGON;
+                    shape->pointsIndex = pointsIndex;
+                    shape->pointsLength = object->pointsLength;
+                    Vector2* points = map->collisionPoints + pointsIndex;
+                    for (uint32_t j = 0; j < object->pointsLength; j++) {
+                        points[j].x = object->points[j].x + (float)object->x;
+                        points[j].y = object->points[j].y + (float)object->y;
+                    }
+                    for (uint32_t j = 0; j < object->pointsLength; j++) {
+                        TmxCollisionEdge* edge = &map->collisionEdges[pointsIndex + j];
+                        Vector2 from = points[j], to = points[(j + 1) % object->pointsLength];
+                        float length = sqrtf(((to.x - from.x) * (to.x - from.x)) + ((to.y - from.y) * (to.y - from.y)));
+                        edge->normal = (Vector2){ (to.y - from.y) / length, -(to.x - from.x) / length };
+                        edge->minimum = INFINITY;
+                        edge->maximum = -INFINITY;
+                        for (uint32_t k = 0; k < object->pointsLength; k++) {
+                            float projection = (points[k].x * edge->normal.x) + (points[k].y * edge->normal.y);
+                            if (projection < edge->minimum)
+                                edge->minimum = projection;
+                            if (projection > edge->maximum)
+                                edge->maximum = projection;
+                        }
+                    }
+                    pointsIndex += object->pointsLength;
+                } else
+                    shape->type = COLLISION_SHAPE_OBJECT;
+            break;
+            default: /* Polylines, text, and tiles */
+                shape->type = COLLISION_SHAPE_OBJECT;
+            break;
+            }
+        }
+        /* A tile whose only shape is a box covering it whole can skip reading the shape */
+        if (objectGroup->objectsLength == 1) {
+            const TmxCollisionShape* shape = &map->collisionShapes[collision->shapesIndex];
+            collision->isFullSquare = shape->type == COLLISION_SHAPE_BOX && shape->aabb.x == 0.0f &&
+                shape->aabb.y == 0.0f && shape->aabb.width == (float)map->tileWidth &&
+                shape->aabb.height == (float)map->tileHeight;
+        }
+    }
+    map->collisionShapesLength = shapesLength;
+    map->collisionPointsLength = pointsLength;
 }
 
-static LoadTextureCallback loadTextureOverride = NULL;
+/* Returns true if the given polygon is convex, having no repeated vertices and turning the same way at every vertex */
+bool IsConvexPolygon(const Vector2* points, uint32_t pointsLength) {
+    if (points == NULL || pointsLength < 3)
+        return false;
 
-RAYTMX_DEC void SetLoadTextureTMX(LoadTextureCallback callback) {
-    loadTextureOverride = callback;
+    float sign = 0.0f;
+    for (uint32_t i = 0; i < pointsLength; i++) {
+        Vector2 a = points[i], b = points[(i + 1) % pointsLength], c = points[(i + 2) % pointsLength];
+        if (a.x == b.x && a.y == b.y) /* A zero-length edge has no normal */
+            return false;
+        float cross = ((b.x - a.x) * (c.y - b.y)) - ((b.y - a.y) * (c.x - b.x));
+        if (cross == 0.0f) /* Collinear edges are fine so long as the rest agree */
+            continue;
+        if (sign == 0.0f)
+            sign = cross;
+        else if ((cross > 0.0f) != (sign > 0.0f))
+            return false;
+    }
+    return sign != 0.0f;
 }
 
-static int tmxLogFlags = 0;
-
-RAYTMX_DEC void TraceLogTMX(int logLevel, const TmxMap* map) {
-    if (map == NULL)
+/* Decodes the layers and loads the external tilesets that were recorded while parsing a TMX document. Each is */
+/* independent of the others so they're spread across a pool of threads. Afterwards, back on the calling thread, the */
+/* external tilesets are merged into the map's <tileset>s and their textures are loaded. */
+void RunLoadJobs(RaytmxState* raytmxState) {
+    uint32_t jobsLength = raytmxState->pendingLayersLength + raytmxState->pendingTilesetsLength;
+    if (jobsLength == 0)
         return;
 
-    switch (map->orientation) {
-    case ORIENTATION_NONE: TraceLog(logLevel, "orientation: none"); break;
-    case ORIENTATION_ORTHOGONAL: TraceLog(logLevel, "orientation: orthogonal"); break;
-    case ORIENTATION_ISOMETRIC: TraceLog(logLevel, "orientation: isometric"); break;
-    case ORIENTATION_STAGGERED: TraceLog(logLevel, "orientation: staggered"); break;
-    case ORIENTATION_HEXAGONAL: TraceLog(logLevel, "orientation: hexagonal"); break;
+    RaytmxLoadJobQueue queue;
+    memset(&queue, 0, sizeof(RaytmxLoadJobQueue));
+    queue.jobs = (RaytmxLoadJob*)MemAllocZero(sizeof(RaytmxLoadJob) * jobsLength);
+    for (RaytmxPendingTilesetNode* iterator = raytmxState->pendingTilesetsRoot; iterator != NULL;
+            iterator = iterator->next) {
+        queue.jobs[queue.jobsLength].pendingTileset = iterator;
+        /* A TSX file's size isn't known until it's read so assume the worst and start it as early as possible */
+        queue.jobs[queue.jobsLength].cost = (size_t)-1;
+        queue.jobsLength += 1;
     }
-
-    switch (map->renderOrder) {
-    case RENDER_ORDER_RIGHT_DOWN: TraceLog(logLevel, "render order: right-down"); break;
-    case RENDER_ORDER_RIGHT_UP: TraceLog(logLevel, "render order: right-up"); break;
-    case RENDER_ORDER_LEFT_DOWN: TraceLog(logLevel, "render order: left-down"); break;
-    case RENDER_ORDER_LEFT_UP: TraceLog(logLevel, "render order: left-up"); break;
+    for (RaytmxPendingLayerNode* iterator = raytmxState->pendingLayersRoot; iterator != NULL;
+            iterator = iterator->next) {
+        queue.jobs[queue.jobsLength].pendingLayer = iterator;
+        queue.jobs[queue.jobsLength].cost = iterator->contentLength;
+        queue.jobsLength += 1;
+    }
+    /* Starting the most expensive jobs first keeps one large layer from being the last thing left running */
+    qsort(queue.jobs, queue.jobsLength, sizeof(RaytmxLoadJob), CompareLoadJobs);
+
+#ifdef RAYTMX_THREADS
+    pthread_t threads[RAYTMX_MAX_WORKER_THREADS];
+    uint32_t threadsLength = 0;
+    pthread_mutex_init(&queue.mutex, NULL);
+    /* The calling thread takes jobs too so one fewer thread than there are jobs is needed */
+    while (threadsLength + 1 < RAYTMX_MAX_WORKER_THREADS && threadsLength + 1 < jobsLength) {
+        if (pthread_create(&threads[threadsLength], NULL, RunLoadJobQueue, &queue) != 0)
+            break; /* The calling thread will still get through every job, if with less help */
+        threadsLength += 1;
+    }
+    RunLoadJobQueue(&queue);
+    for (uint32_t i = 0; i < threadsLength; i++)
+        pthread_join(threads[i], NULL);
+    pthread_mutex_destroy(&queue.mutex);
+#else
+    RunLoadJobQueue(&queue);
+#endif
+    MemFree(queue.jobs);
+
+    /* Merge the external tilesets, along with requests for their textures, into the map's <tileset>s */
+    for (RaytmxPendingTilesetNode* iterator = raytmxState->pendingTilesetsRoot; iterator != NULL;
+            iterator = iterator->next) {
+        if (!iterator->externalTileset.isSuccess)
+            continue;
+        MergeExternalTileset(iterator->tileset, iterator->externalTileset);
+        AppendTextureRequests(raytmxState, iterator->externalTileset.textureRequestsRoot);
+        iterator->externalTileset.textureRequestsRoot = NULL;
+        iterator->externalTileset.isSuccess = false; /* The tileset now belongs to the map */
     }
+}
 
-    TraceLog(logLevel, "width: %u tiles", map->width);
-    TraceLog(logLevel, "height: %u tiles", map->height);
-    TraceLog(logLevel, "tile width: %u pixels", map->tileWidth);
-    TraceLog(logLevel, "tile height: %u pixels", map->tileHeight);
-    if (map->parallaxOriginX != 0)
-        TraceLog(logLevel, "parallax origin X: %d pixels", map->parallaxOriginX);
-    if (map->parallaxOriginY != 0)
-        TraceLog(logLevel, "parallax origin Y: %d pixels", map->parallaxOriginY);
-    if (map->hasBackgroundColor)
-        TraceLog(logLevel, "background color: 0x%08X", map->backgroundColor);
+/* Takes jobs from the queue until there are none left. Run by every thread involved in loading a map. */
+void* RunLoadJobQueue(void* queue) {
+    RaytmxLoadJobQueue* jobQueue = (RaytmxLoadJobQueue*)queue;
+    while (true) {
+#ifdef RAYTMX_THREADS
+        pthread_mutex_lock(&jobQueue->mutex);
+#endif
+        uint32_t index = jobQueue->nextJob;
+        if (index < jobQueue->jobsLength)
+            jobQueue->nextJob += 1;
+#ifdef RAYTMX_THREADS
+        pthread_mutex_unlock(&jobQueue->mutex);
+#endif
+        if (index >= jobQueue->jobsLength)
+            break;
+        RunLoadJob(&jobQueue->jobs[index]);
+    }
+    return NULL;
+}
 
-    TraceLogTMXTilesets(logLevel, map->orientation, map->tilesets, map->tilesetsLength, 0);
-    TraceLogTMXProperties(logLevel, map->properties, map->propertiesLength, 0);
-    TraceLogTMXLayers(logLevel, map->layers, map->layersLength, 0);
+void RunLoadJob(RaytmxLoadJob* job) {
+    if (job->pendingLayer != NULL) {
+        RaytmxPendingLayerNode* pendingLayer = job->pendingLayer;
+        if (pendingLayer->chunk != NULL)
+            DecodeTileChunk(pendingLayer->tileLayer, pendingLayer->layerName, pendingLayer->chunk,
+                pendingLayer->content, pendingLayer->contentLength);
+        else
+            DecodeTileLayerData(pendingLayer->tileLayer, pendingLayer->layerName, pendingLayer->content,
+                pendingLayer->contentLength);
+    } else if (job->pendingTileset != NULL)
+        job->pendingTileset->externalTileset = LoadTSX(job->pendingTileset->fullPath);
 }
 
-RAYTMX_DEC void SetTraceLogFlagsTMX(int logFlags) {
-    tmxLogFlags = logFlags;
+/* qsort() comparator ordering load jobs from most to least expensive */
+int CompareLoadJobs(const void* a, const void* b) {
+    size_t costA = ((const RaytmxLoadJob*)a)->cost, costB = ((const RaytmxLoadJob*)b)->cost;
+    return (costA < costB) - (costA > costB);
 }
 
-/**********************************************************************************************************************/
-/* Private implementation.                                                                                            */
+void MergeExternalTileset(TmxTileset* tileset, RaytmxExternalTileset externalTileset) {
+    /* A <tileset> within a <map> will have two attributes: 'firstgid' and 'source.' The rest of the tileset's */
+    /* details are in the external TSX that 'source' points to. They need to be merged. Remember the two internal */
+    /* attributes. */
+    uint32_t tempFirstGid = tileset->firstGid;
+    char* tempSource = tileset->source;
+    /* The <tileset> may already be closed, in which case it was given default values. The defaults for 'name' and */
+    /* 'class' are replaced by the TSX's. The default object alignment depends on the map's orientation, which the */
+    /* TSX doesn't know, so it's kept unless the TSX specifies one. */
+    TmxObjectAlignment tempObjectAlignment = tileset->objectAlignment;
+    FreeString(tileset->name);
+    FreeString(tileset->classString);
+    /* Assign all values from the TSX's tileset to the one given. This will overrite 'firstGid' and 'source.' */
+    *tileset = externalTileset.tileset;
+    /* Reassign the original 'firstGid' and 'source' values */
+    tileset->firstGid = tempFirstGid;
+    tileset->source = tempSource;
+    if (tileset->objectAlignment == OBJECT_ALIGNMENT_UNSPECIFIED)
+        tileset->objectAlignment = tempObjectAlignment;
+}
 
-RaytmxExternalTileset LoadTSX(const char* fileName) {
-    RaytmxState raytmxState[1];
-    memset(raytmxState, 0, sizeof(RaytmxState)); /* Initialize all values to zero, NULL, or an equivalent enum value */
-    raytmxState->format = FORMAT_TSX;
+/* Requests the texture for the <image> currently being parsed, whose 'source' is relative to the document */
+void AddTextureRequest(RaytmxState* raytmxState, const char* source) {
+    RaytmxTextureRequestNode* textureRequest = (RaytmxTextureRequestNode*)MemAllocZero(
+        sizeof(RaytmxTextureRequestNode));
+    textureRequest->source = source;
+    StringCopyN(textureRequest->fullPath, JoinPath(raytmxState->documentDirectory, source),
+        sizeof(textureRequest->fullPath) - 1);
+    AppendTextureRequests(raytmxState, textureRequest);
+}
 
-    /* Initialize an external tileset object */
-    RaytmxExternalTileset externalTileset;
-    memset(&externalTileset, 0, sizeof(RaytmxExternalTileset));
+/* Moves a list of texture requests, such as those of an external tileset, onto the end of the state's list */
+void AppendTextureRequests(RaytmxState* raytmxState, RaytmxTextureRequestNode* textureRequestsRoot) {
+    if (textureRequestsRoot == NULL)
+        return;
 
-    /* Do format-agnostic parsing of the document. The state object will be populated with raytmx's models of the */
-    /* equivalent TMX, TSX, and/or TX elements. */
-    ParseDocument(raytmxState, fileName);
-    if (!raytmxState->isSuccess)
-        return externalTileset; /* Will have 'isSuccess' set to false to indicate a failure */
+    if (raytmxState->textureRequestsRoot == NULL)
+        raytmxState->textureRequestsRoot = textureRequestsRoot;
+    else
+        raytmxState->textureRequestsTail->next = textureRequestsRoot;
+    RaytmxTextureRequestNode* textureRequestsTail = textureRequestsRoot;
+    while (textureRequestsTail->next != NULL)
+        textureRequestsTail = textureRequestsTail->next;
+    raytmxState->textureRequestsTail = textureRequestsTail;
+}
 
-    if (raytmxState->tilesetsRoot != NULL) { /* If there is at least one tileset */
-        /* Copy the root tileset so it can be returned */
-        externalTileset.tileset = raytmxState->tilesetsRoot->tileset;
-        externalTileset.isSuccess = true;
-        /* TSX files should have only one tileset so any others will be freed/unloaded immediately */
-        RaytmxTilesetNode* tilesetIterator = raytmxState->tilesetsRoot->next;
-        while (tilesetIterator != NULL) {
-            FreeTileset(tilesetIterator->tileset);
-            tilesetIterator = tilesetIterator->next;
+/* Removes the requests for a tileset's textures, which must be done before the tileset is freed since requests */
+/* identify their images by the addresses of the 'source' strings */
+void DiscardTextureRequests(RaytmxState* raytmxState, const TmxTileset* tileset) {
+    RaytmxTextureRequestNode** link = &raytmxState->textureRequestsRoot;
+    raytmxState->textureRequestsTail = NULL;
+    while (*link != NULL) {
+        RaytmxTextureRequestNode* textureRequest = *link;
+        bool isForTileset = tileset->hasImage && textureRequest->source == tileset->image.source;
+        for (uint32_t i = 0; i < tileset->tilesLength && !isForTileset; i++)
+            isForTileset = tileset->tiles[i].hasImage && textureRequest->source == tileset->tiles[i].image.source;
+
+        if (isForTileset) {
+            *link = textureRequest->next;
+            MemFree(textureRequest);
+        } else {
+            raytmxState->textureRequestsTail = textureRequest;
+            link = &textureRequest->next;
         }
-    } else
-        TraceLog(LOG_WARNING, "RAYTMX: TSX file (external tileset) \"%s\" does not contain any tilesets", fileName);
-
-    /* Free the linked lists and zeroize related values */
-    FreeState(raytmxState);
-
-    return externalTileset;
+    }
 }
 
-RaytmxObjectTemplate LoadTX(const char* fileName) {
-    RaytmxState raytmxState[1];
-    memset(raytmxState, 0, sizeof(RaytmxState)); /* Initialize all values to zero, NULL, or an equivalent enum value */
-    raytmxState->format = FORMAT_TX;
-
-    /* Initialize an object template object */
-    RaytmxObjectTemplate objectTemplate;
-    memset(&objectTemplate, 0, sizeof(RaytmxObjectTemplate));
-
-    /* Do format-agnostic parsing of the document. The state object will be populated with raytmx's models of the */
-    /* equivalent TMX, TSX, and/or TX elements. */
-    ParseDocument(raytmxState, fileName);
-    if (!raytmxState->isSuccess)
-        return objectTemplate; /* Will have 'isSuccess' set to false to indicate a failure */
+/* Points each texture request at the image it's for within a finished map. Requests for images that didn't make it */
+/* into the map are freed. Returns the remaining requests. */
+RaytmxTextureRequestNode* FindRequestedImages(TmxMap* map, RaytmxTextureRequestNode* textureRequestsRoot) {
+    RaytmxTextureRequestNode* foundRoot = NULL, **foundLink = &foundRoot;
+    while (textureRequestsRoot != NULL) {
+        RaytmxTextureRequestNode* textureRequest = textureRequestsRoot;
+        textureRequestsRoot = textureRequestsRoot->next;
+        textureRequest->next = NULL;
 
-    if (raytmxState->objectsRoot != NULL) { /* If there is at least one object */
-        /* Copy the root object so it can be returned */
-        objectTemplate.object = raytmxState->objectsRoot->object;
-        objectTemplate.isSuccess = true;
-        /* TX files should have only one object so any others will be freed/unloaded immediately */
-        RaytmxObjectNode* objectIterator = raytmxState->objectsRoot->next;
-        while (objectIterator != NULL) {
-            FreeObject(objectIterator->object);
-            objectIterator = objectIterator->next;
+        for (uint32_t i = 0; i < map->tilesetsLength && textureRequest->image == NULL; i++) {
+            TmxTileset* tileset = &map->tilesets[i];
+            if (tileset->hasImage && tileset->image.source == textureRequest->source)
+                textureRequest->image = &tileset->image;
+            for (uint32_t j = 0; j < tileset->tilesLength && textureRequest->image == NULL; j++) {
+                if (tileset->tiles[j].hasImage && tileset->tiles[j].image.source == textureRequest->source)
+                    textureRequest->image = &tileset->tiles[j].image;
+            }
         }
-    } else
-        TraceLog(LOG_WARNING, "RAYTMX: TX file (object template) \"%s\" does not contain any objects", fileName);
+        if (textureRequest->image == NULL)
+            textureRequest->image = FindLayerImage(map->layers, map->layersLength, textureRequest->source);
+
+        if (textureRequest->image != NULL) {
+            *foundLink = textureRequest;
+            foundLink = &textureRequest->next;
+        } else
+            MemFree(textureRequest);
+    }
+    return foundRoot;
+}
 
-    if (raytmxState->tilesetsRoot != NULL) { /* If there is at least one tileset */
-        /* Object templates may have a tileset. This is for cases where the object references a tile (i.e. its 'gid' */
-        /* attribute is set).  Copy the root tileset so it can be returned */
-        objectTemplate.tileset = raytmxState->tilesetsRoot->tileset;
-        objectTemplate.hasTileset = true;
-        /* TX files should have at most one tileset so any others will be freed/unloaded immediately */
-        RaytmxTilesetNode* tilesetsIterator = raytmxState->tilesetsRoot->next;
-        while (tilesetsIterator != NULL) {
-            FreeTileset(tilesetsIterator->tileset);
-            tilesetsIterator = tilesetsIterator->next;
-        }
+/* Searches image layers, including those within groups, for the image with the given 'source' string */
+TmxImage* FindLayerImage(TmxLayer* layers, uint32_t layersLength, const char* source) {
+    for (uint32_t i = 0; i < layersLength; i++) {
+        if (layers[i].type == LAYER_TYPE_IMAGE_LAYER && layers[i].exact.imageLayer.hasImage &&
+                layers[i].exact.imageLayer.image.source == source)
+            return &layers[i].exact.imageLayer.image;
+        TmxImage* image = FindLayerImage(layers[i].layers, layers[i].layersLength, source);
+        if (image != NULL)
+            return image;
     }
+    return NULL;
+}
 
-    /* Free the linked lists and zeroize related values */
-    FreeState(raytmxState);
+/* Loads the texture of one request into its image, then frees the request. Returns the next request. */
+RaytmxTextureRequestNode* LoadRequestedTexture(RaytmxTextureRequestNode* textureRequest) {
+    RaytmxTextureRequestNode* next = textureRequest->next;
+    textureRequest->image->texture = LoadCachedTexture(textureRequest->fullPath,
+        textureRequest->decodedImage.data != NULL ? &textureRequest->decodedImage : NULL);
+    if (textureRequest->decodedImage.data != NULL)
+        UnloadImage(textureRequest->decodedImage);
+    MemFree(textureRequest);
+    return next;
+}
 
-    return objectTemplate;
+void FreeTextureRequests(RaytmxTextureRequestNode* textureRequestsRoot) {
+    while (textureRequestsRoot != NULL) {
+        RaytmxTextureRequestNode* textureRequest = textureRequestsRoot;
+        textureRequestsRoot = textureRequestsRoot->next;
+        if (textureRequest->decodedImage.data != NULL)
+            UnloadImage(textureRequest->decodedImage);
+        MemFree(textureRequest);
+    }
 }
 
 void ParseDocument(RaytmxState* raytmxState, const char* fileName) {
@@ -1627,6 +3183,9 @@ void HandleElementBegin(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext)
         raytmxState->layer = AddGenericLayer(raytmxState, /* isGroup: */ false);
         raytmxState->layer->type = LAYER_TYPE_TILE_LAYER;
         raytmxState->tileLayer = &raytmxState->layer->exact.tileLayer;
+    } else if (strcmp(hoxmlContext->tag, "chunk") == 0) {
+        if (raytmxState->tileLayer != NULL) /* Infinite maps' <data> is split into <chunk>s with their own positions */
+            raytmxState->chunk = AddChunk(raytmxState);
     } else if (strcmp(hoxmlContext->tag, "objectgroup") == 0) {
         if (raytmxState->tilesetTile != NULL) { /* If the object group is a child of a <tile>, it's collision info */
             raytmxState->objectGroup = &raytmxState->tilesetTile->objectGroup;
@@ -1715,6 +3274,8 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             raytmxState->mapWidth = atoi(hoxmlContext->value);
         else if (strcmp(hoxmlContext->attribute, "height") == 0)
             raytmxState->mapHeight = atoi(hoxmlContext->value);
+        else if (strcmp(hoxmlContext->attribute, "infinite") == 0)
+            raytmxState->mapIsInfinite = atoi(hoxmlContext->value) != 0;
         else if (strcmp(hoxmlContext->attribute, "tilewidth") == 0)
             raytmxState->mapTileWidth = atoi(hoxmlContext->value);
         else if (strcmp(hoxmlContext->attribute, "tileheight") == 0)
@@ -1768,21 +3329,21 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             else if (strcmp(hoxmlContext->attribute, "source") == 0) {
                 raytmxState->tileset->source = (char*)MemAlloc((unsigned int)strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->tileset->source, hoxmlContext->value);
-                /* 'source' points to an external TSX file that defines the majority of the tileset. Try to load it. */
-                RaytmxExternalTileset externalTileset = LoadTSX(JoinPath(raytmxState->documentDirectory,
-                    hoxmlContext->value));
-                if (externalTileset.isSuccess) {
-                    /* A <tileset> within a <map> will have two attributes: 'firstgid' and 'source.' The rest of */
-                    /* the tileset's details are in the external TSX that 'source' points to. They need to be merged. */
-                    /* Remember the two internal attributes. */
-                    uint32_t tempFirstGid = raytmxState->tileset->firstGid;
-                    char* tempSource = raytmxState->tileset->source;
-                    /* Assign all values from the TSX's tileset to the one within the state object. This will */
-                    /* overrite the values of 'firstGid' and 'source.' */
-                    *raytmxState->tileset = externalTileset.tileset;
-                    /* Reassign the original 'firstGid' and 'source' values */
-                    raytmxState->tileset->firstGid = tempFirstGid;
-                    raytmxState->tileset->source = tempSource;
+                /* 'source' points to an external TSX file that defines the majority of the tileset */
+                if (raytmxState->format == FORMAT_TMX) {
+                    /* A map's external tilesets are independent of one another and of the map's layers so they're */
+                    /* loaded in parallel once parsing of the map is done. Remember this one for later. */
+                    RaytmxPendingTilesetNode* pendingTileset = AddPendingTileset(raytmxState);
+                    pendingTileset->tileset = raytmxState->tileset;
+                    StringCopyN(pendingTileset->fullPath, JoinPath(raytmxState->documentDirectory, hoxmlContext->value),
+                        sizeof(pendingTileset->fullPath) - 1);
+                } else { /* Else, an object template's tileset. Templates are rare enough to just load it now. */
+                    char* fullPath = JoinPath(raytmxState->documentDirectory, hoxmlContext->value);
+                    RaytmxExternalTileset externalTileset = LoadTSX(fullPath);
+                    if (externalTileset.isSuccess) {
+                        MergeExternalTileset(raytmxState->tileset, externalTileset);
+                        AppendTextureRequests(raytmxState, externalTileset.textureRequestsRoot);
+                    }
                 }
             } else if (strcmp(hoxmlContext->attribute, "name") == 0) {
                 raytmxState->tileset->name = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
@@ -1839,9 +3400,7 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             if (strcmp(hoxmlContext->attribute, "source") == 0) {
                 raytmxState->image->source = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->image->source, hoxmlContext->value);
-                RaytmxCachedTextureNode* cachedTexture = LoadCachedTexture(raytmxState, hoxmlContext->value);
-                if (cachedTexture != NULL)
-                     raytmxState->image->texture = cachedTexture->texture;
+                AddTextureRequest(raytmxState, raytmxState->image->source);
             } else if (strcmp(hoxmlContext->attribute, "trans") == 0) {
                 raytmxState->image->trans = GetColorFromHexString(hoxmlContext->value);
                 raytmxState->image->hasTrans = true;
@@ -1902,6 +3461,18 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             /* provide any more information than that. Tiled doesn't seem to have a feature for this either. */
         }
     } /* strcmp(hoxmlContext->tag, "data") == 0 */
+    else if (strcmp(hoxmlContext->tag, "chunk") == 0) {
+        if (raytmxState->chunk != NULL) {
+            if (strcmp(hoxmlContext->attribute, "x") == 0)
+                raytmxState->chunk->x = atoi(hoxmlContext->value);
+            else if (strcmp(hoxmlContext->attribute, "y") == 0)
+                raytmxState->chunk->y = atoi(hoxmlContext->value);
+            else if (strcmp(hoxmlContext->attribute, "width") == 0)
+                raytmxState->chunk->width = atoi(hoxmlContext->value);
+            else if (strcmp(hoxmlContext->attribute, "height") == 0)
+                raytmxState->chunk->height = atoi(hoxmlContext->value);
+        }
+    } /* strcmp(hoxmlContext->tag, "chunk") == 0 */
     else if (strcmp(hoxmlContext->tag, "objectgroup") == 0) {
         if (raytmxState->objectGroup != NULL) {
             /* Check for attributes specific to <objectgroup> layers */
@@ -2351,8 +3922,34 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
         raytmxState->animationFrame = NULL;
     else if (strcmp(hoxmlContext->tag, "layer") == 0) {
         if (raytmxState->tileLayer != NULL) {
+            if (raytmxState->chunksRoot != NULL) { /* If this <layer>'s tiles are split into <chunk>s */
+                /* Allocate the array and copy the chunks into it, freeing the nodes while we're at it */
+                TmxTileChunk* chunks = (TmxTileChunk*)MemAllocZero(sizeof(TmxTileChunk) * raytmxState->chunksLength);
+                RaytmxChunkNode* iterator = raytmxState->chunksRoot;
+                for (uint32_t i = 0; i < raytmxState->chunksLength; i++) {
+                    chunks[i] = iterator->chunk;
+                    if (iterator->content != NULL) { /* The chunk's place in the array is final so it can be decoded */
+                        RaytmxPendingLayerNode* pendingLayer = AddPendingLayer(raytmxState);
+                        pendingLayer->tileLayer = raytmxState->tileLayer;
+                        pendingLayer->layerName = raytmxState->layer->name;
+                        pendingLayer->chunk = &chunks[i];
+                        pendingLayer->content = iterator->content;
+                        pendingLayer->contentLength = iterator->contentLength;
+                    }
+                    RaytmxChunkNode* parent = iterator;
+                    iterator = iterator->next;
+                    MemFree(parent);
+                }
+                /* Add the chunks array to the tile layer */
+                raytmxState->tileLayer->chunks = chunks;
+                raytmxState->tileLayer->chunksLength = raytmxState->chunksLength;
+                raytmxState->chunksRoot = NULL;
+                raytmxState->chunksTail = NULL;
+                raytmxState->chunksLength = 0;
+            }
             /* If there were 1+ <tile>s within this <layer> but this <layer> already has tiles (from a <data>?) */
-            if (raytmxState->layerTilesRoot != NULL && raytmxState->tileLayer->tiles != NULL) {
+            else if (raytmxState->layerTilesRoot != NULL && (raytmxState->tileLayer->tiles != NULL ||
+                    raytmxState->isLayerDataPending)) {
                 TraceLog(LOG_WARNING, "RAYTMX: layer \"%s\" has more than one source of tile data - the latter tiles "
                     "for this layer will be dropped", raytmxState->layer->name);
                 /* Free the nodes and tiles therein */
@@ -2362,7 +3959,7 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                     iterator = iterator->next;
                     MemFree(parent);
                 }
-            } else {
+            } else if (!raytmxState->isLayerDataPending) { /* If the tiles aren't waiting on a <data> to be decoded */
                 /* Allocate the array and zeroize every index as initialization */
                 uint32_t* tiles = (uint32_t*)MemAllocZero(sizeof(uint32_t) * raytmxState->layerTilesLength);
                 /* Copy the GID into the array and free the nodes while we're at it */
@@ -2381,6 +3978,7 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             raytmxState->layerTilesRoot = NULL;
             raytmxState->layerTilesTail = NULL;
             raytmxState->layerTilesLength = 0;
+            raytmxState->isLayerDataPending = false;
         }
         raytmxState->tileLayer = NULL;
         raytmxState->layer = NULL;
@@ -2402,137 +4000,51 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
         if (raytmxState->image != NULL) {
             /* TODO (?): The TMX map format documentation says an <image> can contain a <data> element but doesn't */
             /* provide any more information than that. Tiled doesn't seem to have a feature for this either. */
-        } else if (raytmxState->tileLayer != NULL && raytmxState->tileLayer->tiles != NULL) {
+        } else if (raytmxState->tileLayer != NULL && (raytmxState->tileLayer->tiles != NULL ||
+                raytmxState->isLayerDataPending)) {
             TraceLog(LOG_WARNING, "RAYTMX: layer \"%s\" has more than one source of tile data - the latter tiles for "
                 "this layer will be dropped", raytmxState->layer->name);
+        } else if (raytmxState->chunksRoot != NULL) {
+            /* The <data>'s tiles are in its <chunk>s, each of which is decoded when it's first needed */
         } else if (raytmxState->tileLayer != NULL && raytmxState->tileLayer->encoding != NULL) {
-            RaytmxTileLayerTileNode* tiles = NULL;
-            if (strcmp(raytmxState->tileLayer->encoding, "base64") == 0) {
-                /* The layer's data is a series of unsigned, 32-bit integers encoded as a Base64 string. But, XML */
-                /* considers everything between <data> and </data> to be content meaning there is probably some */
-                /* whitespace on both ends of the content we need to ignore. So, find the actual start and stop: */
-                char *encodedStart = hoxmlContext->content, *encodedEnd;
-                while (isspace(*encodedStart))
-                    encodedStart++;
-                encodedEnd = encodedStart + strlen(encodedStart) - 1;
-                while (encodedEnd > encodedStart && isspace(*encodedEnd))
-                    encodedEnd--;
-
-                /* With the string of encoded Base64 data trimmed, decode it */
-                int decodedLength;
-                unsigned char* decoded = DecodeDataBase64((const unsigned char*)encodedStart, &decodedLength);
-                if (decoded != NULL) {
-                    if (raytmxState->tileLayer->compression == NULL) { /* If the Base64-encoded data is uncompressed */
-                        /* Iterate through N bytes ('decodedLength') with every four bytes being a single GID */
-                        /* resulting in N / 4 tiles */
-                        uint32_t* iterator = (uint32_t*)decoded;
-                        for (int i = 0; i < decodedLength / 4; i++) {
-                            AddTileLayerTile(raytmxState, *iterator);
-                            iterator += 1; /* Point to the next unsigned, 32-bit integer in the decoded data */
-                        }
-                    } else { /* If the Base-64encoded data is also compressed */
-                        if (strcmp(raytmxState->tileLayer->compression, "gzip") == 0 ||
-                                strcmp(raytmxState->tileLayer->compression, "zlib") == 0) {
-                            unsigned char* postHeaderDecoded = NULL;
-                            if (strcmp(raytmxState->tileLayer->compression, "gzip") == 0) {
-                                /* The first two bytes of a GZIP header are expected to be a magic number, 0x1F8B, */
-                                /* identifying the format and the third is expected to indicate the compression */
-                                /* method where 0x08 is DEFLATE. */
-                                /* If these values are found, decompression can continue */
-                                if (decoded[0] == 0x1F && decoded[1] == 0x8B && decoded[2] == 0x08) {
-                                    /* Skip past the GZIP header. The header is typically ten bytes. The bytes not */
-                                    /* checked are unimportant things like a timestamp and OS ID. Additional optional */
-                                    /* headers are possible but not used by Tiled so they are assumed to be missing. */
-                                    postHeaderDecoded = decoded + 10;
-                                } else { /* If the GZIP header doesn't match a decompressable one */
-                                    TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" uses GZIP compression but the stream's "
-                                        "header doesn't indicate DEFLATE compression", raytmxState->layer->name);
-                                }
-                            } else /* if (strcmp(raytmxState->tileLayer->compression, "zlib") == 0) */ {
-                                /* The first byte of a ZLIB header is expected to be 0x78 where the 8 indicates the */
-                                /* DEFLATE compression method and the 7 is "compression info" that indicates a 32K */
-                                /* LZ77 window size and, in practice, cannot be anything else. */
-                                /* If these values are found, decompression can continue */
-                                if (decoded[0] == 0x78) {
-                                    /* Skip past the ZLIB header. The header is two bytes. */
-                                    postHeaderDecoded = decoded + 2;
-                                } else { /* If the ZLIB header doesn't match a decompressable one */
-                                    TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" uses ZLIB compression but the stream's "
-                                        "header doesn't indicate DEFLATE compression", raytmxState->layer->name);
-                                }
-                            }
-
-                            if (postHeaderDecoded != NULL) {
-                                /* "zlib" and "gzip" both use the DEFLATE algorithm and raylib provides a */
-                                /* decompression function when it's built with SUPPORT_COMPRESSION_API (default) */
-                                int decompressedLength;
-                                unsigned char* decompressed = DecompressData(postHeaderDecoded, decodedLength,
-                                    &decompressedLength);
-                                if (decompressed != NULL && decompressedLength > 0) {
-                                    uint32_t* iterator = (uint32_t*)decompressed;
-                                    for (int i = 0; i < decompressedLength / 4; i++) {
-                                        AddTileLayerTile(raytmxState, *iterator);
-                                        iterator += 1; /* Point to the next unsigned integer in the decompressed data */
-                                    }
-                                    MemFree(decompressed); /* Free the memory allocated by DecompressData() */
-                                } else { /* raylib wasn't built with compression or allocation failed */
-                                    TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" compressed with \"%s\" cannot be parsed "
-                                        "because DEFLATE decompression failed - either raylib was not built with "
-                                        "SUPPORT_COMPRESSION_API or memory allocation failed", raytmxState->layer->name,
-                                        raytmxState->tileLayer->compression);
-                                }
-                            }
-                        } else {
-                            TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" cannot be parsed because the compression method "
-                                "\"%s\" is unsupported", raytmxState->layer->name, raytmxState->tileLayer->compression);
-                        }
-                    }
-                    MemFree(decoded); /* Free the memory allocated by DecodeDataBase64() */
-                } else {
-                    TraceLog(LOG_ERROR, "RAYTMX: Unable to decode Base64 data for layer \"%s\"",
-                        raytmxState->layer->name);
-                }
-            } /* strcmp(raytmxState->tileLayer->encoding, "base64") == 0 */
-            else if (strcmp(raytmxState->tileLayer->encoding, "csv") == 0) {
-                /* The Comma-Separated Value (CSV) list herein is a series of Global IDs (GIDs) of tiles in the form */
-                /* "31,32,33" where 31, 32, and 33 are GIDs */
-                char valueAsString[16]; /* Needs to fit all digits of a single value - should be more than enough */
-                char* iterator = hoxmlContext->content;
-                while (*iterator != '\0') { /* While not pointing to the end of the end of the string */
-                    memset(valueAsString, '\0', 16); /* Reset the value-as-a-string buffer with all zeroes */
-                    /* Copy each character into the buffer until either a comma or the terminator is reached */
-                    for (int i = 0; *iterator != ',' && *iterator != '\0'; i++) {
-                        memcpy(valueAsString + i, iterator, 1);
-                        iterator++;
-                    }
-                    if (*iterator == ',') /* If iteration was paused by a comma */
-                        iterator++; /* Advance one character so the comma isn't parsed with the value next iteration */
-                    AddTileLayerTile(raytmxState, atoi(valueAsString)); /* Read the value as an integer GID */
-                }
-            } /* strcmp(raytmxState->tileLayer->encoding, "csv") == 0 */
-
-            if (tiles != NULL) { /* If there was no error in parsing the data and there's a linked list of tiles */
-                /* Allocate the array and assign 0 to every index to be safe */
-                uint32_t* tiles = (uint32_t*)MemAlloc(sizeof(uint32_t) * raytmxState->layerTilesLength);
-                memset(tiles, 0, sizeof(uint32_t) * raytmxState->layerTilesLength);
-                /* Copy the GIDs into the array and free the nodes while we're at it */
-                RaytmxTileLayerTileNode* layerTilesIterator = raytmxState->layerTilesRoot;
-                for (uint32_t i = 0; i < raytmxState->layerTilesLength; i++) {
-                    tiles[i] = layerTilesIterator->gid;
-                    RaytmxTileLayerTileNode* layerTilesTemp = layerTilesIterator;
-                    layerTilesIterator = layerTilesIterator->next;
-                    MemFree(layerTilesTemp);
+            /* Decoding, and possibly decompressing, the data is the bulk of the work for a layer and is independent */
+            /* of every other layer. So, keep a copy of the raw content to be decoded in parallel once parsing ends. */
+            RaytmxPendingLayerNode* pendingLayer = AddPendingLayer(raytmxState);
+            pendingLayer->tileLayer = raytmxState->tileLayer;
+            pendingLayer->layerName = raytmxState->layer->name;
+            pendingLayer->contentLength = strlen(hoxmlContext->content);
+            pendingLayer->content = (char*)MemAlloc((unsigned int)pendingLayer->contentLength + 1);
+            StringCopy(pendingLayer->content, hoxmlContext->content);
+            raytmxState->isLayerDataPending = true;
+        } /* raytmxState->tileLayer != NULL && raytmxState->tileLayer->encoding != NULL */
+    } /* strcmp(hoxmlContext->tag, "data") == 0 */
+    else if (strcmp(hoxmlContext->tag, "chunk") == 0) {
+        if (raytmxState->chunk != NULL) {
+            TmxTileChunk* chunk = raytmxState->chunk;
+            if (raytmxState->tileLayer->encoding != NULL) {
+                /* Like a <layer>'s <data>, keep the raw content to be decoded in parallel once parsing ends */
+                RaytmxChunkNode* chunkNode = raytmxState->chunksTail;
+                chunkNode->contentLength = strlen(hoxmlContext->content);
+                chunkNode->content = (char*)MemAlloc((unsigned int)chunkNode->contentLength + 1);
+                StringCopy(chunkNode->content, hoxmlContext->content);
+            } else { /* If the chunk's tiles are <tile> elements, they're kept as they can't be decoded again */
+                chunk->tiles = (uint32_t*)MemAllocZero(sizeof(uint32_t) * chunk->width * chunk->height);
+                chunk->tilesStride = chunk->width;
+                RaytmxTileLayerTileNode* iterator = raytmxState->layerTilesRoot;
+                for (uint32_t i = 0; iterator != NULL; i++) {
+                    if (i < chunk->width * chunk->height)
+                        chunk->tiles[i] = iterator->gid;
+                    RaytmxTileLayerTileNode* parent = iterator;
+                    iterator = iterator->next;
+                    MemFree(parent);
                 }
-                /* Add the tiles array to the element it applies to */
-                raytmxState->tileLayer->tiles = tiles;
-                raytmxState->tileLayer->tilesLength = raytmxState->layerTilesLength;
-                /* Clean up the state object */
                 raytmxState->layerTilesRoot = NULL;
                 raytmxState->layerTilesTail = NULL;
                 raytmxState->layerTilesLength = 0;
             }
-        } /* raytmxState->tileLayer != NULL && raytmxState->tileLayer->encoding != NULL */
-    } /* strcmp(hoxmlContext->tag, "data") == 0 */
+            raytmxState->chunk = NULL;
+        }
+    } /* strcmp(hoxmlContext->tag, "chunk") == 0 */
     else if (strcmp(hoxmlContext->tag, "objectgroup") == 0) {
         if (raytmxState->objectGroup != NULL) {
             if (raytmxState->objectsRoot == NULL)
@@ -2580,6 +4092,7 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             raytmxState->objectGroup->objects = objects;
             raytmxState->objectGroup->objectsLength = raytmxState->objectsLength;
             raytmxState->objectGroup->ySortedObjects = ySortedObjects;
+            BuildObjectGroupBvh(raytmxState->objectGroup);
             /* Clean up the state object */
             raytmxState->objectsRoot = NULL;
             raytmxState->objectsTail = NULL;
@@ -3012,17 +4525,8 @@ void FreeState(RaytmxState* raytmxState) {
     if (raytmxState == NULL)
         return;
 
-    /* Clear the caches. These allow for quick lookups of previously-loaded textures and object templates. They */
-    /* aren't needed once loading is complete. */
-    RaytmxCachedTextureNode *cachedTextureIterator = raytmxState->texturesRoot, *cachedTextureTemp;
-    while (cachedTextureIterator != NULL) {
-        cachedTextureTemp = cachedTextureIterator;
-        cachedTextureIterator = cachedTextureIterator->next;
-        if (cachedTextureTemp->fileName != NULL) /* Just in case. Should always be set. */
-            MemFree(cachedTextureTemp->fileName);
-        MemFree(cachedTextureTemp);
-    }
-    raytmxState->texturesRoot = NULL;
+    /* Clear the template cache. This allows for quick lookups of previously-loaded object templates. It isn't */
+    /* needed once loading is complete. Textures are cached separately, for the whole process, until unloaded. */
     RaytmxCachedTemplateNode *cachedTemplateIterator = raytmxState->templatesRoot, *cachedTemplateTemp;
     while (cachedTemplateIterator != NULL) {
         cachedTemplateTemp = cachedTemplateIterator;
@@ -3034,6 +4538,35 @@ void FreeState(RaytmxState* raytmxState) {
     }
     raytmxState->templatesRoot = NULL;
 
+    /* Free any work left over from loading. Decoded layers and merged tilesets already belong to the layer nodes. */
+    RaytmxPendingLayerNode *pendingLayerIterator = raytmxState->pendingLayersRoot, *pendingLayerTemp;
+    while (pendingLayerIterator != NULL) {
+        pendingLayerTemp = pendingLayerIterator;
+        pendingLayerIterator = pendingLayerIterator->next;
+        if (pendingLayerTemp->content != NULL)
+            MemFree(pendingLayerTemp->content);
+        MemFree(pendingLayerTemp);
+    }
+    raytmxState->pendingLayersRoot = NULL;
+    raytmxState->pendingLayersTail = NULL;
+    raytmxState->pendingLayersLength = 0;
+    RaytmxPendingTilesetNode *pendingTilesetIterator = raytmxState->pendingTilesetsRoot, *pendingTilesetTemp;
+    while (pendingTilesetIterator != NULL) {
+        pendingTilesetTemp = pendingTilesetIterator;
+        pendingTilesetIterator = pendingTilesetIterator->next;
+        if (pendingTilesetTemp->externalTileset.isSuccess) { /* If loaded but never merged into the map */
+            FreeTextureRequests(pendingTilesetTemp->externalTileset.textureRequestsRoot);
+            FreeTileset(pendingTilesetTemp->externalTileset.tileset);
+        }
+        MemFree(pendingTilesetTemp);
+    }
+    raytmxState->pendingTilesetsRoot = NULL;
+    raytmxState->pendingTilesetsTail = NULL;
+    raytmxState->pendingTilesetsLength = 0;
+    FreeTextureRequests(raytmxState->textureRequestsRoot);
+    raytmxState->textureRequestsRoot = NULL;
+    raytmxState->textureRequestsTail = NULL;
+
     raytmxState->property = NULL;
     raytmxState->tileset = NULL;
     raytmxState->image = NULL;
@@ -3046,6 +4579,22 @@ void FreeState(RaytmxState* raytmxState) {
     raytmxState->objectGroup = NULL;
     raytmxState->imageLayer = NULL;
     raytmxState->object = NULL;
+    raytmxState->chunk = NULL;
+
+    /* Free each chunk, and its content, left in the linked list of chunks by a <layer> that never ended */
+    RaytmxChunkNode *chunksIterator = raytmxState->chunksRoot, *chunksTemp;
+    while (chunksIterator != NULL) {
+        chunksTemp = chunksIterator;
+        chunksIterator = chunksIterator->next;
+        if (chunksTemp->content != NULL)
+            MemFree(chunksTemp->content);
+        if (chunksTemp->chunk.tiles != NULL)
+            MemFree(chunksTemp->chunk.tiles);
+        MemFree(chunksTemp);
+    }
+    raytmxState->chunksRoot = NULL;
+    raytmxState->chunksTail = NULL;
+    raytmxState->chunksLength = 0;
 
     /* Free each property in the linked list of properties */
     RaytmxPropertyNode *propertiesIterator = raytmxState->propertiesRoot, *propertiesTemp;
@@ -3139,7 +4688,7 @@ void FreeTileset(TmxTileset tileset) {
     FreeString(tileset.classString);
     if (tileset.hasImage) {
         FreeString(tileset.image.source);
-        UnloadTexture(tileset.image.texture);
+        UnloadCachedTexture(tileset.image.texture);
     }
     if (tileset.properties != NULL) {
         for (uint32_t i = 0; i < tileset.propertiesLength; i++)
@@ -3150,7 +4699,7 @@ void FreeTileset(TmxTileset tileset) {
         TmxTilesetTile tile = tileset.tiles[i];
         if (tile.hasImage) {
             FreeString(tile.image.source);
-            UnloadTexture(tile.image.texture);
+            UnloadCachedTexture(tile.image.texture);
             if (tile.properties != NULL) {
                 for (uint32_t j = 0; j < tile.propertiesLength; j++)
                     FreeProperty(tile.properties[j]);
@@ -3179,16 +4728,32 @@ void FreeLayer(TmxLayer layer) {
     case LAYER_TYPE_TILE_LAYER:
         FreeString(layer.exact.tileLayer.encoding);
         FreeString(layer.exact.tileLayer.compression);
+        for (uint32_t j = 0; j < layer.exact.tileLayer.chunksLength; j++) {
+            TmxTileChunk* chunk = &layer.exact.tileLayer.chunks[j];
+            FreeTileChunkBatches(chunk);
+            if (chunk->collisionBits != NULL)
+                MemFree(chunk->collisionBits);
+            if (layer.exact.tileLayer.tiles == NULL && chunk->tiles != NULL) /* If not pointing into the layer's */
+                MemFree(chunk->tiles);
+        }
+        if (layer.exact.tileLayer.chunks != NULL)
+            MemFree(layer.exact.tileLayer.chunks);
+        if (layer.exact.tileLayer.chunkGrid != NULL)
+            MemFree(layer.exact.tileLayer.chunkGrid);
         MemFree(layer.exact.tileLayer.tiles);
     break;
     case LAYER_TYPE_OBJECT_GROUP:
         for (uint32_t j = 0; j < layer.exact.objectGroup.objectsLength; j++)
             FreeObject(layer.exact.objectGroup.objects[j]);
         MemFree(layer.exact.objectGroup.objects);
+        if (layer.exact.objectGroup.bvhNodes != NULL) {
+            MemFree(layer.exact.objectGroup.bvhNodes);
+            MemFree(layer.exact.objectGroup.bvhObjects);
+        }
     break;
     case LAYER_TYPE_IMAGE_LAYER:
         if (layer.exact.imageLayer.hasImage)
-            UnloadTexture(layer.exact.imageLayer.image.texture);
+            UnloadCachedTexture(layer.exact.imageLayer.image.texture);
     break;
     case LAYER_TYPE_GROUP: break; /* Nothing to do for this case but compilers like to complain */
     }
@@ -3232,6 +4797,21 @@ int Clampi(int value, int minimum, int maximum) {
     return value;
 }
 
+/**
+ * Helper function that divides integers rounding toward negative infinity, rather than toward zero like C's division,
+ * so the tile or chunk containing a negative coordinate is found the same way as for a positive coordinate.
+ *
+ * @param dividend The value to be divided.
+ * @param divisor The value to divide by. Must be positive.
+ * @return The largest integer less than or equal to the quotient.
+ */
+int32_t FloorDivide(int32_t dividend, int32_t divisor) {
+    int32_t quotient = dividend / divisor;
+    if (dividend % divisor != 0 && dividend < 0)
+        quotient -= 1;
+    return quotient;
+}
+
 /**
  * Scary-looking helper function that does something kind of simple: iterates through the tiles of the given tile layer
  * overlapping with the given screen rectangle, one tile per call. This function returns true while iteration is still
@@ -3352,8 +4932,73 @@ bool IterateTileLayer(const TmxMap* map, const TmxTileLayer* layer, Rectangle sc
 }
 
 void DrawTMXTileLayer(const TmxMap* map, Rectangle screenRect, TmxLayer layer, int posX, int posY, Color tint) {
-    if (map == NULL || layer.type != LAYER_TYPE_TILE_LAYER || layer.exact.tileLayer.tilesLength == 0)
+    if (map == NULL || layer.type != LAYER_TYPE_TILE_LAYER || (layer.exact.tileLayer.tilesLength == 0 &&
+            layer.exact.tileLayer.chunksLength == 0))
+        return;
+
+    const TmxTileLayer* tileLayer = &layer.exact.tileLayer;
+    if (tileLayer->chunks != NULL) { /* If the layer has been split into chunks */
+        if (tint.a == 0 || map->tileWidth == 0 || map->tileHeight == 0)
+            return;
+
+        /* Translation matrix placing the meshes, built in layer space, at the layer's position */
+        Matrix transform = {
+            1.0f, 0.0f, 0.0f, (float)posX,
+            0.0f, 1.0f, 0.0f, (float)posY,
+            0.0f, 0.0f, 1.0f, 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f
+        };
+        /* The range of tiles on screen, widened by a chunk each way as larger tiles may reach beyond their chunks */
+        int32_t fromX = (int32_t)floorf((screenRect.x - posX) / map->tileWidth) - (int32_t)tileLayer->chunkWidth;
+        int32_t fromY = (int32_t)floorf((screenRect.y - posY) / map->tileHeight) - (int32_t)tileLayer->chunkHeight;
+        int32_t toX = (int32_t)floorf((screenRect.x + screenRect.width - posX) / map->tileWidth) +
+            (int32_t)tileLayer->chunkWidth;
+        int32_t toY = (int32_t)floorf((screenRect.y + screenRect.height - posY) / map->tileHeight) +
+            (int32_t)tileLayer->chunkHeight;
+        uint32_t cursor = 0;
+        const TmxTileChunk* chunk;
+        while ((chunk = NextTileChunk(tileLayer, fromX, fromY, toX, toY, &cursor)) != NULL) {
+            if (chunk->isResident) {
+                Rectangle bounds = chunk->bounds;
+                bounds.x += posX;
+                bounds.y += posY;
+                if (!CheckCollisionRecs(screenRect, bounds)) /* If nothing in the chunk is visible */
+                    continue;
+
+                if (chunk->batchesLength > 0) {
+                    /* Meshes are drawn immediately so anything already queued in raylib's batch has to go first */
+                    rlDrawRenderBatchActive();
+                    /* One draw call per texture, or per 16384 tiles of it, rather than one per tile */
+                    for (uint32_t i = 0; i < chunk->batchesLength; i++) {
+                        TmxTileBatch batch = chunk->batches[i];
+                        batch.material.maps[MATERIAL_MAP_DIFFUSE].color = tint;
+                        DrawMesh(batch.mesh, batch.material, transform);
+                    }
+                }
+
+                /* Animated tiles change their source rectangles so they're drawn individually, after static tiles */
+                for (uint32_t i = 0; i < chunk->animatedTilesLength; i++) {
+                    uint32_t column = chunk->animatedTiles[i] % chunk->width;
+                    uint32_t row = chunk->animatedTiles[i] / chunk->width;
+                    DrawTMXLayerTile(/* map: */ map, /* screenRect: */ screenRect,
+                        /* rawGid: */ chunk->tiles[(row * chunk->tilesStride) + column],
+                        /* posX: */ posX + ((chunk->x + (int32_t)column) * (int32_t)map->tileWidth),
+                        /* posY: */ posY + ((chunk->y + (int32_t)row) * (int32_t)map->tileHeight), /* tint: */ tint);
+                }
+            } else if (chunk->tiles != NULL) { /* If the chunk is evicted or not built yet, draw its tiles */
+                for (uint32_t row = 0; row < chunk->height; row++) {
+                    for (uint32_t column = 0; column < chunk->width; column++) {
+                        DrawTMXLayerTile(/* map: */ map, /* screenRect: */ screenRect,
+                            /* rawGid: */ chunk->tiles[(row * chunk->tilesStride) + column],
+                            /* posX: */ posX + ((chunk->x + (int32_t)column) * (int32_t)map->tileWidth),
+                            /* posY: */ posY + ((chunk->y + (int32_t)row) * (int32_t)map->tileHeight),
+                            /* tint: */ tint);
+                    }
+                }
+            }
+        }
         return;
+    }
 
     /* Iterate through each tile that the screen rectangle overlaps with */
     uint32_t rawGid;
@@ -3365,11 +5010,19 @@ void DrawTMXTileLayer(const TmxMap* map, Rectangle screenRect, TmxLayer layer, i
     }
 }
 
-void DrawTextureTile(Texture2D texture, Rectangle source, Rectangle dest, bool flipX, bool flipY, bool flipDiag,
-        Color tint) {
-    if (texture.id == 0) /* If the texture is invalid */
-        return;
-
+/**
+ * Helper function that determines the texture coordinates of each corner of a tile's quad, with any flips resolved.
+ * This is shared by immediate drawing of single tiles and by the meshes built ahead of time for whole tile layers.
+ *
+ * @param texture The texture the tile is extracted from.
+ * @param source Sub-rectangle, in pixels, of the texture that is the tile.
+ * @param flipX When true, the tile is flipped horizontally.
+ * @param flipY When true, the tile is flipped vertically.
+ * @param flipDiag When true, the tile is flipped diagonally (i.e. its bottom-left and top-right corners are swapped).
+ * @param texCoords Output. Four texture coordinates for the quad's top-left, bottom-left, bottom-right, and top-right
+ *                  corners, in that order.
+ */
+void GetTileTexCoords(Texture2D texture, Rectangle source, bool flipX, bool flipY, bool flipDiag, Vector2* texCoords) {
     float textureWidth = (float)texture.width;
     float textureHeight = (float)texture.height;
 
@@ -3393,16 +5046,36 @@ void DrawTextureTile(Texture2D texture, Rectangle source, Rectangle dest, bool f
         sourceTopRight = temp;
     }
 
-    /* Determine the area on the screen to be drawn to */
-    Vector2 destTopLeft, destTopRight, destBottomLeft, destBottomRight;
-    destTopLeft.x = dest.x;
-    destTopLeft.y = dest.y;
-    destTopRight.x = dest.x + dest.width;
-    destTopRight.y = dest.y;
-    destBottomLeft.x = dest.x;
-    destBottomLeft.y = dest.y + dest.height;
-    destBottomRight.x = dest.x + dest.width;
-    destBottomRight.y = dest.y + dest.height;
+    if (flipX && flipY) { /* Flipping both ways is a half turn */
+        texCoords[0] = sourceBottomRight;
+        texCoords[1] = sourceTopRight;
+        texCoords[2] = sourceTopLeft;
+        texCoords[3] = sourceBottomLeft;
+    } else if (flipX) {
+        texCoords[0] = sourceTopRight;
+        texCoords[1] = sourceBottomRight;
+        texCoords[2] = sourceBottomLeft;
+        texCoords[3] = sourceTopLeft;
+    } else if (flipY) {
+        texCoords[0] = sourceBottomLeft;
+        texCoords[1] = sourceTopLeft;
+        texCoords[2] = sourceTopRight;
+        texCoords[3] = sourceBottomRight;
+    } else {
+        texCoords[0] = sourceTopLeft;
+        texCoords[1] = sourceBottomLeft;
+        texCoords[2] = sourceBottomRight;
+        texCoords[3] = sourceTopRight;
+    }
+}
+
+void DrawTextureTile(Texture2D texture, Rectangle source, Rectangle dest, bool flipX, bool flipY, bool flipDiag,
+        Color tint) {
+    if (texture.id == 0) /* If the texture is invalid */
+        return;
+
+    Vector2 texCoords[4];
+    GetTileTexCoords(texture, source, flipX, flipY, flipDiag, texCoords);
 
     rlSetTexture(texture.id);
     rlBegin(RL_QUADS);
@@ -3411,52 +5084,17 @@ void DrawTextureTile(Texture2D texture, Rectangle source, Rectangle dest, bool f
         rlNormal3f(0.0f, 0.0f, 1.0f); /* Normal vector pointing towards viewer */
 
         /* Top-left corner of the quad */
-        if (flipX && !flipY)
-            rlTexCoord2f(sourceTopRight.x, sourceTopRight.y);
-        else if (flipY && !flipX)
-            rlTexCoord2f(sourceBottomLeft.x, sourceBottomLeft.y);
-        else
-            rlTexCoord2f(sourceTopLeft.x, sourceTopLeft.y);
-        if (flipX && flipY)
-            rlVertex2f(destBottomRight.x, destBottomRight.y);
-        else
-            rlVertex2f(destTopLeft.x, destTopLeft.y);
-
+        rlTexCoord2f(texCoords[0].x, texCoords[0].y);
+        rlVertex2f(dest.x, dest.y);
         /* Bottom-left corner of the quad */
-        if (flipX && !flipY)
-            rlTexCoord2f(sourceBottomRight.x, sourceBottomRight.y);
-        else if (flipY && !flipX)
-            rlTexCoord2f(sourceTopLeft.x, sourceTopLeft.y);
-        else
-            rlTexCoord2f(sourceBottomLeft.x, sourceBottomLeft.y);
-        if (flipX && flipY)
-            rlVertex2f(destTopRight.x, destTopRight.y);
-        else
-            rlVertex2f(destBottomLeft.x, destBottomLeft.y);
-
+        rlTexCoord2f(texCoords[1].x, texCoords[1].y);
+        rlVertex2f(dest.x, dest.y + dest.height);
         /* Bottom-right corner of the quad */
-        if (flipX && !flipY)
-            rlTexCoord2f(sourceBottomLeft.x, sourceBottomLeft.y);
-        else if (flipY && !flipX)
-            rlTexCoord2f(sourceTopRight.x, sourceTopRight.y);
-        else
-            rlTexCoord2f(sourceBottomRight.x, sourceBottomRight.y);
-        if (flipX && flipY)
-            rlVertex2f(destTopLeft.x, destTopLeft.y);
-        else
-            rlVertex2f(destBottomRight.x, destBottomRight.y);
-
+        rlTexCoord2f(texCoords[2].x, texCoords[2].y);
+        rlVertex2f(dest.x + dest.width, dest.y + dest.height);
         /* Top-right corner of the quad */
-        if (flipX && !flipY)
-            rlTexCoord2f(sourceTopLeft.x, sourceTopLeft.y);
-        else if (flipY && !flipX)
-            rlTexCoord2f(sourceBottomRight.x, sourceBottomRight.y);
-        else
-            rlTexCoord2f(sourceTopRight.x, sourceTopRight.y);
-        if (flipX && flipY)
-            rlVertex2f(destBottomLeft.x, destBottomLeft.y);
-        else
-            rlVertex2f(destTopRight.x, destTopRight.y);
+        rlTexCoord2f(texCoords[3].x, texCoords[3].y);
+        rlVertex2f(dest.x + dest.width, dest.y);
     }
     rlEnd();
     rlSetTexture(0);
@@ -3481,9 +5119,8 @@ void DrawTMXLayerTile(const TmxMap* map, Rectangle screenRect, uint32_t rawGid,
     if (tile.hasAnimation) {
         /* Animations aren't really tiles. Instead, they contain frames that identify a tile to draw for the duration */
         /* of that frame. */
-        /* The 'gid' of an animation tile is assigned with the first GID of the tileset and the frames have local IDs */
-        /* within that tileset. The GID of the frame, then, can be calculated by adding them together. */
-        gid = tile.gid + tile.animation.frames[tile.frameIndex].id;
+        /* AnimateTMX() keeps the GID of the current frame's tile up to date. */
+        gid = tile.frameGid;
         /* Copy any flip flags that may be present in the layer data. */
         gid |= rawGid & (FLIP_FLAG_HORIZONTAL | FLIP_FLAG_VERTICAL | FLIP_FLAG_DIAGONAL | FLIP_FLAG_ROTATE_120);
         /* Draw the tile using the calculated GID of the frame, along with the possible flags. */
@@ -3530,7 +5167,7 @@ void DrawTMXObjectTile(const TmxMap* map, Rectangle screenRect, uint32_t rawGid,
     if (tile.hasAnimation) {
         /* Animations aren't really tiles. Instead, they contain frames that identify a tile to draw for the duration */
         /* of that frame. That current tile should be drawn. */
-        DrawTMXLayerTile(map, screenRect, tile.gid + tile.animation.frames[tile.frameIndex].id, posX, posY, tint);
+        DrawTMXLayerTile(map, screenRect, tile.frameGid, posX, posY, tint);
     } else {
         /* Determine the area in which to draw, and potentially stretch, the texture. This area matches that of the */
         /* <object>, not the tile size. This also means that the Y coordinate needs consideration because raylib */
@@ -3920,46 +5557,294 @@ TmxObject TranslateObject(TmxObject object, float dx, float dy) {
  * @param map A loaded map model containing the given layers.
  * @param layers An array of select tile layers or group layers to be checked for collisions.
  * @param layersLength Length of the given array of tile layers.
- * @param object A TMX <object> to be checked for a collision.
- * @param outputObject Output parameter assigned with the object in the tile layer that the given object collided with.
+ * @param query The shape to be checked for a collision, as created by CreateCollisionQuery().
+ * @param outputObject Output parameter assigned with the object in the tile layer that the given shape collided with.
  *                     NULL if not wanted.
- * @return True if one of the given tile layers collides with the given object, or false if there is no collision.
+ * @return True if one of the given tile layers collides with the given shape, or false if there is no collision.
  */
 bool CheckCollisionTMXTileLayerObject(const TmxMap* map, const TmxLayer* layers, uint32_t layersLength,
-        TmxObject object, TmxObject* outputObject) {
-    if (map == NULL || layers == NULL || layersLength == 0)
-        return false;
+        const RaytmxCollisionQuery* query, TmxObject* outputObject) {
+    if (map == NULL || map->gidsToCollision == NULL || layers == NULL || layersLength == 0)
+        return false; /* No layers to check or no tiles with collision information */
 
     /* Iterate through each layer and check their tiles for collisions with the given object */
     for (uint32_t i = 0; i < layersLength; i++) {
         if (layers[i].type == LAYER_TYPE_TILE_LAYER) { /* If the layer has tiles */
-            /* Iterate through each tile that the object's Axis-Aligned Bounding Box (AABB) overlaps with */
-            TmxTile tile;
-            Rectangle tileRect;
-            while (IterateTileLayer(/* map: */ map, /* layer: */ &layers[i].exact.tileLayer,
-                    /* screenRect: */ object.aabb, /* rawGid: */ NULL, /* tile: */ &tile, /* tileRect: */ &tileRect)) {
-                /* Iterate through each object associated with the tile */
-                for (uint32_t j = 0; j < tile.objectGroup.objectsLength; j++) {
-                    /* This object, the tile's collision information, has a relative position so this object must be */
-                    /* translated to the position of the tile as it would be drawn with the layer */
-                    TmxObject positionedObject = TranslateObject(tile.objectGroup.objects[j], tileRect.x, tileRect.y);
-                    /* If this tile's object collides with the given object */
-                    if (CheckCollisionTMXObjects(positionedObject, object)) {
-                        if (outputObject != NULL)
-                            *outputObject = positionedObject;
-                        return true; /* Found a collision. Exit now to save some CPU cycles. */
+            /* Check each tile that the object's Axis-Aligned Bounding Box (AABB) overlaps with */
+            if (CheckCollisionTMXTileLayerCells(map, &layers[i].exact.tileLayer, query, outputObject))
+                return true;
+        } else if (layers[i].type == LAYER_TYPE_GROUP) { /* If the layer contains other layers */
+            if (CheckCollisionTMXTileLayerObject(map, layers[i].layers, layers[i].layersLength, query, outputObject))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Helper function that flattens the given layers into a list of their tile layers, descending into groups, so batched
+ * collision checks don't need to walk the layer hierarchy for every shape.
+ *
+ * @param layers An array of select tile layers or group layers to be searched.
+ * @param layersLength Length of the given array of layers.
+ * @param tileLayers Output array of tile layers. Only the first 'tileLayersCapacity' tile layers are written to it.
+ * @param tileLayersCapacity Length of the given output array.
+ * @return The number of tile layers found, which may exceed the capacity of the output array.
+ */
+uint32_t CollectTileLayers(const TmxLayer* layers, uint32_t layersLength, const TmxTileLayer** tileLayers,
+        uint32_t tileLayersCapacity) {
+    uint32_t tileLayersLength = 0;
+    for (uint32_t i = 0; i < layersLength; i++) {
+        if (layers[i].type == LAYER_TYPE_TILE_LAYER) {
+            if (tileLayersLength < tileLayersCapacity)
+                tileLayers[tileLayersLength] = &layers[i].exact.tileLayer;
+            tileLayersLength += 1;
+        } else if (layers[i].type == LAYER_TYPE_GROUP) {
+            uint32_t remainingCapacity = tileLayersLength < tileLayersCapacity ?
+                tileLayersCapacity - tileLayersLength : 0;
+            tileLayersLength += CollectTileLayers(layers[i].layers, layers[i].layersLength,
+                tileLayers + (remainingCapacity > 0 ? tileLayersLength : 0), remainingCapacity);
+        }
+    }
+    return tileLayersLength;
+}
+
+/**
+ * Helper function that describes the given object as a shape to be checked for collisions with tiles. Rectangles,
+ * circles, and points are checked against tiles' collision shapes with dedicated tests. Anything else is checked as an
+ * object.
+ *
+ * @param object The object to be checked for collisions.
+ * @return A query that can be passed to tile collision checks.
+ */
+RaytmxCollisionQuery CreateCollisionQuery(TmxObject object) {
+    RaytmxCollisionQuery query;
+    memset(&query, 0, sizeof(RaytmxCollisionQuery)); /* Zero initialize */
+
+    query.aabb = object.aabb;
+    query.object = object;
+    if (object.type == OBJECT_TYPE_RECTANGLE)
+        query.type = COLLISION_SHAPE_BOX;
+    else if (object.type == OBJECT_TYPE_ELLIPSE && object.width == object.height) {
+        query.type = COLLISION_SHAPE_CIRCLE;
+        query.radius = (float)object.width / 2.0f;
+        query.center = (Vector2){ (float)object.x + query.radius, (float)object.y + query.radius };
+    } else if (object.type == OBJECT_TYPE_POINT) {
+        query.type = COLLISION_SHAPE_POINT;
+        query.center = (Vector2){ (float)object.x, (float)object.y };
+    } else
+        query.type = COLLISION_SHAPE_OBJECT;
+
+    return query;
+}
+
+/**
+ * Helper function for checking for collisions between a single tile layer and a shape. Each chunk the shape's
+ * Axis-Aligned Bounding Box (AABB) overlaps is checked using its bitmap of tiles with collision shapes, skipping 32
+ * tiles without any at a time. Each tile that has shapes is then checked using its pre-calculated collision shapes.
+ *
+ * @param map A loaded map model containing the given tile layer.
+ * @param tileLayer The tile layer to be checked for collisions.
+ * @param query The shape to be checked for a collision, as created by CreateCollisionQuery().
+ * @param outputObject Output parameter assigned with the object in the tile layer that the given shape collided with.
+ *                     NULL if not wanted.
+ * @return True if the given tile layer collides with the given shape, or false if there is no collision.
+ */
+bool CheckCollisionTMXTileLayerCells(const TmxMap* map, const TmxTileLayer* tileLayer,
+        const RaytmxCollisionQuery* query, TmxObject* outputObject) {
+    if (map->tileWidth == 0 || map->tileHeight == 0)
+        return false;
+
+    /* The range of tiles the shape's AABB overlaps */
+    int32_t fromX = (int32_t)floorf(query->aabb.x / (float)map->tileWidth);
+    int32_t fromY = (int32_t)floorf(query->aabb.y / (float)map->tileHeight);
+    int32_t toX = (int32_t)floorf((query->aabb.x + query->aabb.width) / (float)map->tileWidth);
+    int32_t toY = (int32_t)floorf((query->aabb.y + query->aabb.height) / (float)map->tileHeight);
+
+    uint32_t cursor = 0;
+    const TmxTileChunk* chunk;
+    while ((chunk = NextTileChunk(tileLayer, fromX, fromY, toX, toY, &cursor)) != NULL) {
+        if (chunk->tiles == NULL || chunk->collisionBits == NULL) /* If no tile has any shapes */
+            continue;
+
+        /* The part of the range within this chunk, relative to the chunk */
+        uint32_t fromColumn = fromX > chunk->x ? (uint32_t)(fromX - chunk->x) : 0;
+        uint32_t fromRow = fromY > chunk->y ? (uint32_t)(fromY - chunk->y) : 0;
+        uint32_t toColumn = (uint32_t)(toX - chunk->x) < chunk->width ? (uint32_t)(toX - chunk->x) : chunk->width - 1;
+        uint32_t toRow = (uint32_t)(toY - chunk->y) < chunk->height ? (uint32_t)(toY - chunk->y) : chunk->height - 1;
+        uint32_t wordsPerRow = (chunk->width + 31) / 32;
+
+        for (uint32_t row = fromRow; row <= toRow; row++) {
+            const uint32_t* rowBits = chunk->collisionBits + (row * wordsPerRow);
+            for (uint32_t word = fromColumn / 32; word <= toColumn / 32; word++) {
+                /* Keep only the bits of tiles within the range, then visit each set bit */
+                uint32_t bits = rowBits[word];
+                if (word == fromColumn / 32)
+                    bits &= UINT32_MAX << (fromColumn % 32);
+                if (word == toColumn / 32 && toColumn % 32 != 31)
+                    bits &= (1u << ((toColumn % 32) + 1)) - 1;
+                while (bits != 0) {
+                    uint32_t column = (word * 32) + (uint32_t)CountTrailingZeros(bits);
+                    bits &= bits - 1;
+                    uint32_t gid = GetGid(chunk->tiles[(row * chunk->tilesStride) + column], NULL, NULL, NULL, NULL);
+                    TmxTileCollision collision = map->gidsToCollision[gid]; /* The bit means the GID is known */
+
+                    /* The shapes are relative to the tile so they're offset by the tile's position with the layer */
+                    Vector2 offset = { (float)((chunk->x + (int32_t)column) * (int32_t)map->tileWidth),
+                        (float)((chunk->y + (int32_t)row) * (int32_t)map->tileHeight) };
+                    const TmxObjectGroup* objectGroup = &map->gidsToTileMetadata[gid].objectGroup;
+                    for (uint32_t j = 0; j < collision.shapesLength; j++) {
+                        const TmxCollisionShape* shape = &map->collisionShapes[collision.shapesIndex + j];
+                        bool isColliding;
+                        if (collision.isFullSquare) { /* The tile is the shape so it can be checked without reading */
+                            Rectangle tileRect = { offset.x, offset.y, (float)map->tileWidth, (float)map->tileHeight };
+                            isColliding = CheckCollisionRecs(tileRect, query->aabb) &&
+                                (query->type == COLLISION_SHAPE_BOX || CheckCollisionTileShape(map, shape, offset,
+                                query, &objectGroup->objects[shape->objectIndex]));
+                        } else
+                            isColliding = CheckCollisionTileShape(map, shape, offset, query,
+                                &objectGroup->objects[shape->objectIndex]);
+                        if (isColliding) {
+                            if (outputObject != NULL)
+                                *outputObject = TranslateObject(objectGroup->objects[shape->objectIndex], offset.x,
+                                    offset.y);
+                            return true; /* Found a collision. Exit now to save some CPU cycles. */
+                        }
                     }
                 }
             }
-        } else if (layers[i].type == LAYER_TYPE_GROUP) { /* If the layer contains other layers */
-            if (CheckCollisionTMXTileLayerObject(map, layers[i].layers, layers[i].layersLength, object, outputObject))
-                return true;
         }
     }
 
     return false;
 }
 
+/**
+ * Helper function for checking for a collision between one of a tile's collision shapes and a shape being queried.
+ * Pairs of boxes, circles, points, and convex polygons have dedicated tests. Anything else falls back to checking the
+ * objects with CheckCollisionTMXObjects().
+ *
+ * @param map A loaded map model containing the shape's vertices and edges, if it's a convex polygon.
+ * @param shape The tile's collision shape.
+ * @param offset Position of the tile the shape belongs to.
+ * @param query The shape to be checked for a collision, as created by CreateCollisionQuery().
+ * @param object The object the tile's collision shape was made from.
+ * @return True if the shapes collide, or false if they do not.
+ */
+bool CheckCollisionTileShape(const TmxMap* map, const TmxCollisionShape* shape, Vector2 offset,
+        const RaytmxCollisionQuery* query, const TmxObject* object) {
+    /* Perform a quick collision check on the Axis-Aligned Bounding Boxes (AABB) before more accurate checks */
+    Rectangle aabb = shape->aabb;
+    aabb.x += offset.x;
+    aabb.y += offset.y;
+    if (!CheckCollisionRecs(aabb, query->aabb))
+        return false;
+
+    if (shape->type == COLLISION_SHAPE_OBJECT || query->type == COLLISION_SHAPE_OBJECT)
+        return CheckCollisionTMXObjects(TranslateObject(*object, offset.x, offset.y), query->object);
+
+    Vector2 center = { shape->center.x + offset.x, shape->center.y + offset.y };
+    switch (shape->type) {
+    case COLLISION_SHAPE_BOX: /* The tile's shape */
+        switch (query->type) {
+        case COLLISION_SHAPE_BOX: return true; /* The AABBs are the shapes and they collide */
+        case COLLISION_SHAPE_CIRCLE: return CheckCollisionCircleRec(query->center, query->radius, aabb);
+        case COLLISION_SHAPE_POINT: return CheckCollisionPointRec(query->center, aabb);
+        default: return false;
+        }
+
+    case COLLISION_SHAPE_CIRCLE: /* The tile's shape */
+        switch (query->type) {
+        case COLLISION_SHAPE_BOX: return CheckCollisionCircleRec(center, shape->radius, query->aabb);
+        case COLLISION_SHAPE_CIRCLE: return CheckCollisionCircles(center, shape->radius, query->center, query->radius);
+        case COLLISION_SHAPE_POINT: return CheckCollisionPointCircle(query->center, center, shape->radius);
+        default: return false;
+        }
+
+    case COLLISION_SHAPE_POINT: /* The tile's shape */
+        switch (query->type) {
+        case COLLISION_SHAPE_BOX: return CheckCollisionPointRec(center, query->aabb);
+        case COLLISION_SHAPE_CIRCLE: return CheckCollisionPointCircle(center, query->center, query->radius);
+        case COLLISION_SHAPE_POINT: return center.x == query->center.x && center.y == query->center.y;
+        default: return false;
+        }
+
+    case COLLISION_SHAPE_CONVEX_POLYGON: /* The tile's shape */
+        return CheckCollisionConvexPolygonQuery(map->collisionPoints + shape->pointsIndex,
+            map->collisionEdges + shape->pointsIndex, shape->pointsLength, offset, query);
+
+    default: return false;
+    }
+}
+
+/**
+ * Helper function for checking for a collision between a convex polygon and a box, circle, or point being queried
+ * using the Separating Axis Theorem (SAT): two convex shapes are apart if, and only if, there is an axis onto which
+ * their projections do not overlap. The polygon's projections onto its edge normals are pre-calculated so only the
+ * query needs projecting. A box's own axes are X and Y, already covered by the AABB check.
+ *
+ * @param points The polygon's vertices, relative to the tile.
+ * @param edges The polygon's edges, each beginning at the vertex with the same index.
+ * @param pointsLength Number of vertices, and edges, in the polygon.
+ * @param offset Position of the tile the polygon belongs to.
+ * @param query The box, circle, or point to be checked for a collision.
+ * @return True if the shapes collide, or false if they do not.
+ */
+bool CheckCollisionConvexPolygonQuery(const Vector2* points, const TmxCollisionEdge* edges, uint32_t pointsLength,
+        Vector2 offset, const RaytmxCollisionQuery* query) {
+    /* Describe the query by its center and how far it extends from the center on each axis */
+    Vector2 center = query->center;
+    float halfWidth = 0.0f, halfHeight = 0.0f, radius = 0.0f;
+    if (query->type == COLLISION_SHAPE_BOX) {
+        halfWidth = query->aabb.width / 2.0f;
+        halfHeight = query->aabb.height / 2.0f;
+        center = (Vector2){ query->aabb.x + halfWidth, query->aabb.y + halfHeight };
+    } else if (query->type == COLLISION_SHAPE_CIRCLE)
+        radius = query->radius;
+    /* Work relative to the tile, the space the polygon's projections were calculated in */
+    center.x -= offset.x;
+    center.y -= offset.y;
+
+    for (uint32_t i = 0; i < pointsLength; i++) {
+        TmxCollisionEdge edge = edges[i];
+        float projection = (center.x * edge.normal.x) + (center.y * edge.normal.y);
+        float extent = (fabsf(edge.normal.x) * halfWidth) + (fabsf(edge.normal.y) * halfHeight) + radius;
+        if (projection + extent < edge.minimum || projection - extent > edge.maximum)
+            return false; /* Found a separating axis */
+    }
+
+    if (query->type == COLLISION_SHAPE_CIRCLE) {
+        /* A circle can also be separated along the axis from the polygon's nearest vertex to the circle's center */
+        Vector2 nearest = points[0];
+        float nearestDistanceSquared = INFINITY;
+        for (uint32_t i = 0; i < pointsLength; i++) {
+            float dx = center.x - points[i].x, dy = center.y - points[i].y;
+            if ((dx * dx) + (dy * dy) < nearestDistanceSquared) {
+                nearestDistanceSquared = (dx * dx) + (dy * dy);
+                nearest = points[i];
+            }
+        }
+        if (nearestDistanceSquared > 0.0f) {
+            float distance = sqrtf(nearestDistanceSquared);
+            Vector2 axis = { (center.x - nearest.x) / distance, (center.y - nearest.y) / distance };
+            float minimum = INFINITY, maximum = -INFINITY;
+            for (uint32_t i = 0; i < pointsLength; i++) {
+                float projection = (points[i].x * axis.x) + (points[i].y * axis.y);
+                if (projection < minimum)
+                    minimum = projection;
+                if (projection > maximum)
+                    maximum = projection;
+            }
+            float projection = (center.x * axis.x) + (center.y * axis.y);
+            if (projection + radius < minimum || projection - radius > maximum)
+                return false;
+        }
+    }
+
+    return true;
+}
+
 /**
  * Helper function for checking for collisions between an object group and an object of arbitrary type.
  *
@@ -3970,15 +5855,149 @@ bool CheckCollisionTMXTileLayerObject(const TmxMap* map, const TmxLayer* layers,
  * @return True if an object in the object group collides with the given object, or false if there is no collision.
  */
 bool CheckCollisionTMXObjectGroupObject(TmxObjectGroup group, TmxObject object, TmxObject* outputObject) {
-    for (size_t i = 0; i < group.objectsLength; i++) {
-        if (CheckCollisionTMXObjects(group.objects[i], object)) {
-            if (outputObject != NULL)
-                *outputObject = group.objects[i];
-            return true;
+    if (group.bvhNodes == NULL) { /* If the group is small enough to not have a BVH */
+        for (size_t i = 0; i < group.objectsLength; i++) {
+            if (CheckCollisionTMXObjects(group.objects[i], object)) {
+                if (outputObject != NULL)
+                    *outputObject = group.objects[i];
+                return true;
+            }
         }
+        return false;
     }
 
-    return false;
+    /* Walk the BVH, skipping every node whose bounds the object's AABB doesn't touch. When the caller wants the */
+    /* colliding object, the one with the lowest index is reported so the result matches checking them in order. */
+    uint32_t stack[64]; /* The BVH is balanced so its depth is well under this for any 32-bit number of objects */
+    uint32_t stackLength = 0;
+    uint32_t hitIndex = UINT32_MAX;
+    stack[stackLength++] = 0; /* Start at the root */
+    while (stackLength > 0) {
+        const TmxObjectGroupNode* node = &group.bvhNodes[stack[--stackLength]];
+        if (!CheckCollisionRecs(node->aabb, object.aabb))
+            continue;
+        if (node->count == 0) { /* If the node is a branch */
+            stack[stackLength++] = node->index; /* Right child */
+            stack[stackLength++] = (uint32_t)(node - group.bvhNodes) + 1; /* Left child, visited first */
+            continue;
+        }
+        for (uint32_t i = node->index; i < node->index + node->count; i++) {
+            uint32_t objectIndex = group.bvhObjects[i];
+            if (objectIndex < hitIndex && CheckCollisionTMXObjects(group.objects[objectIndex], object)) {
+                if (outputObject == NULL)
+                    return true; /* Any collision will do. Exit now to save some CPU cycles. */
+                hitIndex = objectIndex;
+            }
+        }
+    }
+
+    if (hitIndex == UINT32_MAX)
+        return false;
+    *outputObject = group.objects[hitIndex];
+    return true;
+}
+
+/**
+ * Helper function that builds a Bounding Volume Hierarchy (BVH) over the objects of the given group from their
+ * Axis-Aligned Bounding Boxes (AABBs). The AABBs are calculated when each <object> ends so they are ready by the time
+ * the <objectgroup> ends. Groups with too few objects to benefit are left without one.
+ *
+ * @param group The object group whose 'objects' have been set and whose BVH will be built.
+ */
+void BuildObjectGroupBvh(TmxObjectGroup* group) {
+    if (group->objectsLength <= RAYTMX_OBJECTS_PER_LEAF)
+        return;
+
+    group->bvhObjects = (uint32_t*)MemAlloc(sizeof(uint32_t) * group->objectsLength);
+    for (uint32_t i = 0; i < group->objectsLength; i++)
+        group->bvhObjects[i] = i;
+    /* A binary tree with N leaves has 2N - 1 nodes and there is at least one object per leaf */
+    group->bvhNodes = (TmxObjectGroupNode*)MemAllocZero(sizeof(TmxObjectGroupNode) * (2 * group->objectsLength - 1));
+    group->bvhNodesLength = 0;
+    BuildObjectGroupBvhNode(group, 0, group->objectsLength, &group->bvhNodesLength);
+}
+
+/**
+ * Helper function that recursively builds a node of an object group's BVH, and its children, over a range of
+ * 'bvhObjects.' Each branch splits its objects in half at the median of their centers along its longer axis, keeping
+ * the tree balanced.
+ *
+ * @param group The object group whose BVH is being built.
+ * @param first Index into 'bvhObjects' of the first object beneath the node.
+ * @param count Number of objects beneath the node.
+ * @param nodesLength Number of nodes created so far. Incremented by every node created.
+ * @return Index of the created node.
+ */
+uint32_t BuildObjectGroupBvhNode(TmxObjectGroup* group, uint32_t first, uint32_t count, uint32_t* nodesLength) {
+    uint32_t nodeIndex = (*nodesLength)++;
+    uint32_t* indexes = group->bvhObjects + first;
+
+    /* Calculate the bounds of the objects beneath this node */
+    float minX = INFINITY, maxX = -INFINITY, minY = INFINITY, maxY = -INFINITY;
+    for (uint32_t i = 0; i < count; i++) {
+        Rectangle aabb = group->objects[indexes[i]].aabb;
+        if (aabb.x < minX)
+            minX = aabb.x;
+        if (aabb.x + aabb.width > maxX)
+            maxX = aabb.x + aabb.width;
+        if (aabb.y < minY)
+            minY = aabb.y;
+        if (aabb.y + aabb.height > maxY)
+            maxY = aabb.y + aabb.height;
+    }
+    group->bvhNodes[nodeIndex].aabb = (Rectangle){ minX, minY, maxX - minX, maxY - minY };
+
+    if (count <= RAYTMX_OBJECTS_PER_LEAF) { /* If the objects fit in a leaf */
+        group->bvhNodes[nodeIndex].index = first;
+        group->bvhNodes[nodeIndex].count = count;
+        return nodeIndex;
+    }
+
+    /* Partially sort the objects (i.e. quickselect) so the lower half by center along the longer axis comes first */
+    bool isSplitOnX = maxX - minX >= maxY - minY;
+    uint32_t half = count / 2, low = 0, high = count - 1;
+    while (low < high) {
+        Rectangle pivotAabb = group->objects[indexes[(low + high) / 2]].aabb;
+        float pivot = isSplitOnX ? pivotAabb.x + (pivotAabb.width / 2.0f) : pivotAabb.y + (pivotAabb.height / 2.0f);
+        uint32_t i = low, j = high;
+        while (i <= j) {
+            Rectangle aabb;
+            for (;;) {
+                aabb = group->objects[indexes[i]].aabb;
+                if ((isSplitOnX ? aabb.x + (aabb.width / 2.0f) : aabb.y + (aabb.height / 2.0f)) >= pivot)
+                    break;
+                i += 1;
+            }
+            for (;;) {
+                aabb = group->objects[indexes[j]].aabb;
+                if ((isSplitOnX ? aabb.x + (aabb.width / 2.0f) : aabb.y + (aabb.height / 2.0f)) <= pivot)
+                    break;
+                j -= 1;
+            }
+            if (i <= j) {
+                uint32_t temp = indexes[i];
+                indexes[i] = indexes[j];
+                indexes[j] = temp;
+                i += 1;
+                if (j == 0)
+                    break;
+                j -= 1;
+            }
+        }
+        /* Keep only the side containing the median */
+        if (half <= j)
+            high = j;
+        else if (half >= i)
+            low = i;
+        else
+            break;
+    }
+
+    /* The left child is created next, right after this node, then the right child after all of the left's nodes */
+    BuildObjectGroupBvhNode(group, first, half, nodesLength);
+    group->bvhNodes[nodeIndex].index = BuildObjectGroupBvhNode(group, first + half, count - half, nodesLength);
+    group->bvhNodes[nodeIndex].count = 0;
+    return nodeIndex;
 }
 
 void TraceLogTMXTilesets(int logLevel, TmxOrientation orientation, TmxTileset* tilesets, uint32_t tilesetsLength,
@@ -4172,6 +6191,8 @@ void TraceLogTMXLayers(int logLevel, TmxLayer* layers, uint32_t layersLength, in
                     TraceLog(logLevel, "%s    width: %u", padding, layer.exact.tileLayer.width);
                 if (layer.exact.tileLayer.height != 0)
                     TraceLog(logLevel, "%s    height: %u", padding, layer.exact.tileLayer.height);
+                if (layer.exact.tileLayer.chunksLength != 0)
+                    TraceLog(logLevel, "%s    chunks: %u", padding, layer.exact.tileLayer.chunksLength);
                 if (tmxLogFlags & LOG_SKIP_TILES)
                     TraceLog(logLevel, "%s    skipping %u tiles", padding, layer.exact.tileLayer.tilesLength);
                 else {
@@ -4359,6 +6380,19 @@ void AddTileLayerTile(RaytmxState* raytmxState, uint32_t gid) {
     raytmxState->layerTilesLength += 1;
 }
 
+TmxTileChunk* AddChunk(RaytmxState* raytmxState) {
+    RaytmxChunkNode* node = (RaytmxChunkNode*)MemAllocZero(sizeof(RaytmxChunkNode));
+
+    if (raytmxState->chunksRoot == NULL)
+        raytmxState->chunksRoot = node;
+    else
+        raytmxState->chunksTail->next = node;
+    raytmxState->chunksTail = node;
+    raytmxState->chunksLength += 1;
+
+    return &node->chunk;
+}
+
 TmxTileset* AddTileset(RaytmxState* raytmxState) {
     RaytmxTilesetNode* node = (RaytmxTilesetNode*)MemAllocZero(sizeof(RaytmxTilesetNode));
 
@@ -4444,6 +6478,32 @@ TmxObject* AddObject(RaytmxState* raytmxState) {
     return &node->object;
 }
 
+RaytmxPendingLayerNode* AddPendingLayer(RaytmxState* raytmxState) {
+    RaytmxPendingLayerNode* node = (RaytmxPendingLayerNode*)MemAllocZero(sizeof(RaytmxPendingLayerNode));
+
+    if (raytmxState->pendingLayersRoot == NULL)
+        raytmxState->pendingLayersRoot = node;
+    else
+        raytmxState->pendingLayersTail->next = node;
+    raytmxState->pendingLayersTail = node;
+    raytmxState->pendingLayersLength += 1;
+
+    return node;
+}
+
+RaytmxPendingTilesetNode* AddPendingTileset(RaytmxState* raytmxState) {
+    RaytmxPendingTilesetNode* node = (RaytmxPendingTilesetNode*)MemAllocZero(sizeof(RaytmxPendingTilesetNode));
+
+    if (raytmxState->pendingTilesetsRoot == NULL)
+        raytmxState->pendingTilesetsRoot = node;
+    else
+        raytmxState->pendingTilesetsTail->next = node;
+    raytmxState->pendingTilesetsTail = node;
+    raytmxState->pendingTilesetsLength += 1;
+
+    return node;
+}
+
 void AppendLayerTo(TmxMap* map, RaytmxLayerNode* groupNode, RaytmxLayerNode* layersRoot, uint32_t layersLength) {
     if (map == NULL || layersRoot == NULL || layersLength == 0)
         return;
@@ -4472,44 +6532,143 @@ void AppendLayerTo(TmxMap* map, RaytmxLayerNode* groupNode, RaytmxLayerNode* lay
     }
 }
 
-RaytmxCachedTextureNode* LoadCachedTexture(RaytmxState* raytmxState, const char* fileName) {
-    if (raytmxState == NULL || fileName == NULL)
-        return NULL;
+/* Textures loaded by any map, hashed by their full paths. Entries live until the last tileset, tile, or image */
+/* layer using them is freed so maps loaded after, or alongside, another map can reuse its textures. An entry whose */
+/* file has been modified since is stale: it's no longer reused, so a reloaded map gets the new image, but it stays */
+/* until the maps already using it are freed. */
+static RaytmxCachedTextureNode* textureCache[RAYTMX_TEXTURE_CACHE_BUCKETS];
+#ifdef RAYTMX_THREADS
+/* Textures are only loaded and unloaded on the main thread but LoadTMXAsync()'s thread checks what's cached */
+static pthread_mutex_t textureCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/* Finds or loads the texture for an image and adds a reference to it. If given, 'decodedImage' is uploaded rather */
+/* than reading the file again. Each successful call must be matched by a call to UnloadCachedTexture(). Like */
+/* raylib's LoadTexture(), this uploads to the GPU so it must be called from the thread that owns the OpenGL context. */
+Texture2D LoadCachedTexture(const char* fullPath, const Image* decodedImage) {
+    Texture2D texture;
+    memset(&texture, 0, sizeof(Texture2D));
+    if (fullPath == NULL)
+        return texture;
+
+    uint32_t fileNameHash = HashString(fullPath);
+#ifdef RAYTMX_THREADS
+    pthread_mutex_lock(&textureCacheMutex);
+#endif
+    RaytmxCachedTextureNode** bucket = &textureCache[fileNameHash & (RAYTMX_TEXTURE_CACHE_BUCKETS - 1)];
 
     /* First try to find an already-loaded texture identified by the file name */
-    RaytmxCachedTextureNode* cachedTextureNode = raytmxState->texturesRoot;
+    RaytmxCachedTextureNode* cachedTextureNode = *bucket;
     while (cachedTextureNode != NULL) {
-        /* If the file name associated with the node matches the given file name */
-        if (strcmp(cachedTextureNode->fileName, fileName) == 0)
-            return cachedTextureNode;
+        /* If the file name associated with the node matches the given file name and the file hasn't changed */
+        if (IsCachedTextureCurrent(cachedTextureNode, fullPath, fileNameHash)) {
+            cachedTextureNode->referenceCount += 1;
+            texture = cachedTextureNode->texture;
+            break;
+        }
         cachedTextureNode = cachedTextureNode->next;
     }
 
-    /* Try to load the texture */
-    char* fullPath = JoinPath(raytmxState->documentDirectory, fileName);
-    Texture2D texture = loadTextureOverride ? loadTextureOverride(fullPath) : LoadTexture(fullPath);
-    if (texture.id == 0) { /* If loading the texture failed */
-        TraceLog(LOG_ERROR, "RAYTMX: Unable to load texture \"%s\"", fullPath);
-        return NULL;
+    if (cachedTextureNode == NULL) { /* If the texture isn't loaded yet */
+        /* Try to load the texture */
+        if (decodedImage != NULL)
+            texture = LoadTextureFromImage(*decodedImage);
+        else
+            texture = loadTextureOverride ? loadTextureOverride(fullPath) : LoadTexture(fullPath);
+
+        if (texture.id == 0) /* If loading the texture failed */
+            TraceLog(LOG_ERROR, "RAYTMX: Unable to load texture \"%s\"", fullPath);
+        else {
+            /* Create a new node and add it to the front of its bucket */
+            cachedTextureNode = (RaytmxCachedTextureNode*)MemAllocZero(sizeof(RaytmxCachedTextureNode));
+            cachedTextureNode->fileName = (char*)MemAllocZero((unsigned int)strlen(fullPath) + 1);
+            StringCopy(cachedTextureNode->fileName, fullPath);
+            cachedTextureNode->fileNameHash = fileNameHash;
+            cachedTextureNode->texture = texture;
+            cachedTextureNode->referenceCount = 1;
+            cachedTextureNode->fileModTime = GetFileModTime(fullPath);
+            cachedTextureNode->next = *bucket;
+            *bucket = cachedTextureNode;
+        }
     }
+#ifdef RAYTMX_THREADS
+    pthread_mutex_unlock(&textureCacheMutex);
+#endif
+
+    return texture;
+}
 
-    /* Create a new node in the list of known textures */
-    cachedTextureNode = (RaytmxCachedTextureNode*)MemAllocZero(sizeof(RaytmxCachedTextureNode));
-    cachedTextureNode->fileName = (char*)MemAllocZero((unsigned int)strlen(fileName) + 1);
-    StringCopy(cachedTextureNode->fileName, fileName);
-    cachedTextureNode->texture = texture;
+/* Removes a reference to a texture returned by LoadCachedTexture(), unloading it once nothing else is using it */
+void UnloadCachedTexture(Texture2D texture) {
+    if (texture.id == 0)
+        return;
 
-    /* Add to the cache */
-    if (raytmxState->texturesRoot == NULL)
-        raytmxState->texturesRoot = cachedTextureNode;
-    else {
-        RaytmxCachedTextureNode* cachedTextureIterator = raytmxState->texturesRoot;
-        while (cachedTextureIterator->next != NULL)
-            cachedTextureIterator = cachedTextureIterator->next;
-        cachedTextureIterator->next = cachedTextureNode;
+#ifdef RAYTMX_THREADS
+    pthread_mutex_lock(&textureCacheMutex);
+#endif
+    /* Releasing happens once per image when a map is unloaded so a scan of every bucket is acceptable here */
+    bool isFound = false;
+    for (uint32_t i = 0; i < RAYTMX_TEXTURE_CACHE_BUCKETS && !isFound; i++) {
+        RaytmxCachedTextureNode** link = &textureCache[i];
+        while (*link != NULL) {
+            RaytmxCachedTextureNode* cachedTextureNode = *link;
+            if (cachedTextureNode->texture.id == texture.id) {
+                cachedTextureNode->referenceCount -= 1;
+                if (cachedTextureNode->referenceCount == 0) { /* If this was the last reference */
+                    *link = cachedTextureNode->next;
+                    UnloadTexture(cachedTextureNode->texture);
+                    MemFree(cachedTextureNode->fileName);
+                    MemFree(cachedTextureNode);
+                }
+                isFound = true;
+                break;
+            }
+            link = &cachedTextureNode->next;
+        }
     }
+#ifdef RAYTMX_THREADS
+    pthread_mutex_unlock(&textureCacheMutex);
+#endif
+
+    if (!isFound)
+        TraceLog(LOG_WARNING, "RAYTMX: Texture %u was not loaded by raytmx and will not be unloaded", texture.id);
+}
 
-    return cachedTextureNode;
+/* Checks whether a texture for the given image is already in VRAM. Safe to call from any thread. */
+bool IsTextureCached(const char* fullPath) {
+    uint32_t fileNameHash = HashString(fullPath);
+    bool isCached = false;
+#ifdef RAYTMX_THREADS
+    pthread_mutex_lock(&textureCacheMutex);
+#endif
+    RaytmxCachedTextureNode* cachedTextureNode = textureCache[fileNameHash & (RAYTMX_TEXTURE_CACHE_BUCKETS - 1)];
+    for (; cachedTextureNode != NULL && !isCached; cachedTextureNode = cachedTextureNode->next)
+        isCached = IsCachedTextureCurrent(cachedTextureNode, fullPath, fileNameHash);
+#ifdef RAYTMX_THREADS
+    pthread_mutex_unlock(&textureCacheMutex);
+#endif
+    return isCached;
+}
+
+/* Checks whether a cached texture is of the given file as it is now, marking it stale if the file has changed since */
+/* it was loaded. The texture cache's mutex must be held. */
+bool IsCachedTextureCurrent(RaytmxCachedTextureNode* cachedTextureNode, const char* fullPath, uint32_t fileNameHash) {
+    if (cachedTextureNode->isStale || cachedTextureNode->fileNameHash != fileNameHash ||
+            strcmp(cachedTextureNode->fileName, fullPath) != 0)
+        return false;
+    if (GetFileModTime(fullPath) != cachedTextureNode->fileModTime) /* If the file was saved again, e.g. edited */
+        cachedTextureNode->isStale = true;
+    return !cachedTextureNode->isStale;
+}
+
+/* 32-bit FNV-1a hash of a null-terminated string */
+uint32_t HashString(const char* str) {
+    uint32_t hash = 2166136261u;
+    for (; *str != '\0'; str++) {
+        hash ^= (unsigned char)*str;
+        hash *= 16777619u;
+    }
+    return hash;
 }
 
 RaytmxCachedTemplateNode* LoadCachedTemplate(RaytmxState* raytmxState, const char* fileName) {
@@ -4557,9 +6716,13 @@ RaytmxCachedTemplateNode* LoadCachedTemplate(RaytmxState* raytmxState, const cha
                 break;
             }
         }
+        AppendTextureRequests(raytmxState, objectTemplate.textureRequestsRoot);
         if (isNew) {
             TmxTileset* tileset = AddTileset(raytmxState);
             *tileset = objectTemplate.tileset;
+        } else { /* The duplicate is not needed */
+            DiscardTextureRequests(raytmxState, &objectTemplate.tileset);
+            FreeTileset(objectTemplate.tileset);
         }
     }
 
@@ -4622,6 +6785,331 @@ uint32_t GetGid(uint32_t rawGid, bool* isFlippedHorizontally, bool* isFlippedVer
     return rawGid & ~(FLIP_FLAG_HORIZONTAL | FLIP_FLAG_VERTICAL | FLIP_FLAG_DIAGONAL | FLIP_FLAG_ROTATE_120);
 }
 
+/* Decodes, and decompresses if needed, the content of a tile layer's <data> into the layer's array of GIDs. This */
+/* touches nothing but the given layer so it is safe to call for different layers on different threads at once. */
+void DecodeTileLayerData(TmxTileLayer* tileLayer, const char* layerName, const char* content, size_t contentLength) {
+    /* The tiles are decoded directly into the array that will belong to the layer, skipping the linked list */
+    uint32_t* tiles = NULL;
+    uint32_t tilesLength = 0;
+    if (strcmp(tileLayer->encoding, "base64") == 0) {
+        /* The layer's data is a series of unsigned, 32-bit integers encoded as a Base64 string. But, XML */
+        /* considers everything between <data> and </data> to be content meaning there is probably some */
+        /* whitespace on both ends of the content we need to ignore. So, find the actual start and stop: */
+        const char *encodedStart = content, *encodedEnd;
+        while (isspace(*encodedStart))
+            encodedStart++;
+        encodedEnd = encodedStart + strlen(encodedStart);
+        while (encodedEnd > encodedStart && isspace(*(encodedEnd - 1)))
+            encodedEnd--;
+        size_t encodedLength = (size_t)(encodedEnd - encodedStart);
+        /* Every four characters of Base64 decode into three bytes. Round up to a whole number of GIDs. */
+        size_t decodedCapacity = (((encodedLength + 3) / 4 * 3) + 3) / 4 * 4;
+        size_t decodedLength = 0;
+
+        if (tileLayer->compression == NULL) { /* If the Base64-encoded data is uncompressed */
+            /* Every four decoded bytes are a single GID so the bytes can be the layer's array as they are */
+            tiles = (uint32_t*)MemAllocZero((unsigned int)decodedCapacity);
+            if (DecodeBase64(encodedStart, encodedLength, (unsigned char*)tiles, decodedCapacity,
+                    &decodedLength))
+                tilesLength = (uint32_t)(decodedLength / 4);
+            else {
+                TraceLog(LOG_ERROR, "RAYTMX: Unable to decode Base64 data for layer \"%s\"",
+                    layerName);
+                MemFree(tiles);
+                tiles = NULL;
+            }
+        } else { /* If the Base-64encoded data is also compressed */
+            unsigned char* decoded = (unsigned char*)MemAlloc((unsigned int)decodedCapacity);
+            if (!DecodeBase64(encodedStart, encodedLength, decoded, decodedCapacity, &decodedLength)) {
+                TraceLog(LOG_ERROR, "RAYTMX: Unable to decode Base64 data for layer \"%s\"",
+                    layerName);
+            } else if (strcmp(tileLayer->compression, "gzip") == 0 ||
+                    strcmp(tileLayer->compression, "zlib") == 0) {
+                unsigned char* postHeaderDecoded = NULL;
+                size_t headerLength = 0;
+                if (strcmp(tileLayer->compression, "gzip") == 0) {
+                    /* The first two bytes of a GZIP header are expected to be a magic number, 0x1F8B, */
+                    /* identifying the format and the third is expected to indicate the compression */
+                    /* method where 0x08 is DEFLATE. */
+                    /* If these values are found, decompression can continue */
+                    if (decodedLength > 10 && decoded[0] == 0x1F && decoded[1] == 0x8B && decoded[2] == 0x08) {
+                        /* Skip past the GZIP header. The header is typically ten bytes. The bytes not */
+                        /* checked are unimportant things like a timestamp and OS ID. Additional optional */
+                        /* headers are possible but not used by Tiled so they are assumed to be missing. */
+                        headerLength = 10;
+                        postHeaderDecoded = decoded + headerLength;
+                    } else { /* If the GZIP header doesn't match a decompressable one */
+                        TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" uses GZIP compression but the stream's "
+                            "header doesn't indicate DEFLATE compression", layerName);
+                    }
+                } else /* if (strcmp(tileLayer->compression, "zlib") == 0) */ {
+                    /* The first byte of a ZLIB header is expected to be 0x78 where the 8 indicates the */
+                    /* DEFLATE compression method and the 7 is "compression info" that indicates a 32K */
+                    /* LZ77 window size and, in practice, cannot be anything else. */
+                    /* If these values are found, decompression can continue */
+                    if (decodedLength > 2 && decoded[0] == 0x78) {
+                        /* Skip past the ZLIB header. The header is two bytes. */
+                        headerLength = 2;
+                        postHeaderDecoded = decoded + headerLength;
+                    } else { /* If the ZLIB header doesn't match a decompressable one */
+                        TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" uses ZLIB compression but the stream's "
+                            "header doesn't indicate DEFLATE compression", layerName);
+                    }
+                }
+
+                if (postHeaderDecoded != NULL) {
+                    /* "zlib" and "gzip" both use the DEFLATE algorithm and raylib provides a */
+                    /* decompression function when it's built with SUPPORT_COMPRESSION_API (default) */
+                    int decompressedLength;
+                    unsigned char* decompressed = DecompressData(postHeaderDecoded,
+                        (int)(decodedLength - headerLength), &decompressedLength);
+                    if (decompressed != NULL && decompressedLength > 0) {
+                        /* The decompressed bytes are already an array of GIDs, allocated the same way */
+                        /* MemAlloc() allocates, so the layer takes ownership of them without a copy */
+                        tiles = (uint32_t*)decompressed;
+                        tilesLength = (uint32_t)decompressedLength / 4;
+                    } else { /* raylib wasn't built with compression or allocation failed */
+                        TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" compressed with \"%s\" cannot be parsed "
+                            "because DEFLATE decompression failed - either raylib was not built with "
+                            "SUPPORT_COMPRESSION_API or memory allocation failed", layerName,
+                            tileLayer->compression);
+                        if (decompressed != NULL)
+                            MemFree(decompressed);
+                    }
+                }
+            } else {
+                TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" cannot be parsed because the compression method "
+                    "\"%s\" is unsupported", layerName, tileLayer->compression);
+            }
+            MemFree(decoded);
+        }
+    } /* strcmp(tileLayer->encoding, "base64") == 0 */
+    else if (strcmp(tileLayer->encoding, "csv") == 0) {
+        /* The Comma-Separated Value (CSV) list herein is a series of Global IDs (GIDs) of tiles in the form */
+        /* "31,32,33" where 31, 32, and 33 are GIDs */
+        /* A finite map's layer has exactly width * height tiles. Otherwise, count the commas to find out. */
+        uint32_t tilesCapacity = tileLayer->width * tileLayer->height;
+        if (tilesCapacity == 0) {
+            tilesCapacity = 1;
+            for (const char* iterator = content; *iterator != '\0'; iterator++) {
+                if (*iterator == ',')
+                    tilesCapacity++;
+            }
+        }
+        tiles = (uint32_t*)MemAllocZero(sizeof(uint32_t) * tilesCapacity);
+        tilesLength = DecodeCsvTiles(content, contentLength, tiles, tilesCapacity);
+        if (tilesLength > tilesCapacity) {
+            TraceLog(LOG_WARNING, "RAYTMX: Layer \"%s\" has %u tiles in its data but only %u were expected - "
+                "the extra tiles will be dropped", layerName, tilesLength, tilesCapacity);
+            tilesLength = tilesCapacity;
+        }
+    } /* strcmp(tileLayer->encoding, "csv") == 0 */
+
+    if (tiles != NULL) { /* If there was no error in decoding the data */
+        /* Add the tiles array to the element it applies to */
+        tileLayer->tiles = tiles;
+        tileLayer->tilesLength = tilesLength;
+    }
+}
+
+/* Decodes 'encodedLength' characters of Base64 directly into 'output' which can hold 'outputCapacity' bytes. */
+/* Whitespace is skipped and decoding stops at the first padding character. Unlike raylib's DecodeDataBase64(), this */
+/* doesn't allocate so tile layer data can be decoded straight into the layer's array of GIDs. */
+bool DecodeBase64(const char* encoded, size_t encodedLength, unsigned char* output, size_t outputCapacity,
+        size_t* outputLength) {
+    /* 6-bit value of every ASCII character where 64 is whitespace, 65 is padding ('='), and 255 is invalid */
+    static const unsigned char base64Values[256] = {
+        255, 255, 255, 255, 255, 255, 255, 255, 255,  64,  64, 255, 255,  64, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+         64, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,  62, 255, 255, 255,  63,
+         52,  53,  54,  55,  56,  57,  58,  59,  60,  61, 255, 255, 255,  65, 255, 255,
+        255,   0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,
+         15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25, 255, 255, 255, 255, 255,
+        255,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,
+         41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  51, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255
+    };
+
+    size_t i = 0, o = 0; /* Index into 'encoded' and 'output', respectively */
+
+#ifdef RAYTMX_SSE2
+    /* Decode 16 characters into 12 bytes at a time for as long as every character in the block is part of the */
+    /* Base64 alphabet. The first block with whitespace, padding, or anything invalid is left to the scalar loop. */
+    /* Four bytes are stored for every three decoded so 16 bytes of room are required for a block's 12. */
+    while (encodedLength - i >= 16 && outputCapacity - o >= 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(encoded + i));
+        /* Classify each character by range. Bytes >= 0x80 are negative as signed chars so they match no range. */
+        __m128i isUpper = _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8('A' - 1)),
+            _mm_cmplt_epi8(chunk, _mm_set1_epi8('Z' + 1)));
+        __m128i isLower = _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8('a' - 1)),
+            _mm_cmplt_epi8(chunk, _mm_set1_epi8('z' + 1)));
+        __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8('0' - 1)),
+            _mm_cmplt_epi8(chunk, _mm_set1_epi8('9' + 1)));
+        __m128i isPlus = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('+'));
+        __m128i isSlash = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('/'));
+        __m128i isValid = _mm_or_si128(_mm_or_si128(isUpper, isLower), _mm_or_si128(isDigit,
+            _mm_or_si128(isPlus, isSlash)));
+        if (_mm_movemask_epi8(isValid) != 0xFFFF)
+            break;
+
+        /* Each range maps to its 6-bit values with a single addition: 'A' -> 0, 'a' -> 26, '0' -> 52, etc. */
+        __m128i offsets = _mm_or_si128(
+            _mm_or_si128(_mm_and_si128(isUpper, _mm_set1_epi8(-65)), _mm_and_si128(isLower, _mm_set1_epi8(-71))),
+            _mm_or_si128(_mm_and_si128(isDigit, _mm_set1_epi8(4)),
+                _mm_or_si128(_mm_and_si128(isPlus, _mm_set1_epi8(19)), _mm_and_si128(isSlash, _mm_set1_epi8(16)))));
+        __m128i sextets = _mm_add_epi8(chunk, offsets);
+
+        /* Every 32-bit lane now holds four sextets, A through D with A in the lowest byte, that form three bytes */
+        __m128i lowByte = _mm_set1_epi32(0xFF);
+        __m128i a = _mm_and_si128(sextets, lowByte);
+        __m128i b = _mm_and_si128(_mm_srli_epi32(sextets, 8), lowByte);
+        __m128i c = _mm_and_si128(_mm_srli_epi32(sextets, 16), lowByte);
+        __m128i d = _mm_srli_epi32(sextets, 24);
+        /* Pack them so the lane's three lowest bytes are the decoded bytes in order: AAAAAABB BBBBCCCC CCDDDDDD */
+        __m128i packed = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(a, 2), _mm_srli_epi32(b, 4)),
+            _mm_or_si128(_mm_slli_epi32(_mm_and_si128(b, _mm_set1_epi32(0x0F)), 12),
+                _mm_or_si128(_mm_slli_epi32(_mm_srli_epi32(c, 2), 8),
+                    _mm_or_si128(_mm_slli_epi32(_mm_and_si128(c, _mm_set1_epi32(0x03)), 22),
+                        _mm_slli_epi32(d, 16)))));
+
+        /* Write the lanes three bytes apart. Each write's fourth byte is overwritten by the next lane. */
+        uint32_t lanes[4];
+        _mm_storeu_si128((__m128i*)lanes, packed);
+        memcpy(output + o, &lanes[0], 4);
+        memcpy(output + o + 3, &lanes[1], 4);
+        memcpy(output + o + 6, &lanes[2], 4);
+        memcpy(output + o + 9, &lanes[3], 4);
+        i += 16;
+        o += 12;
+    }
+#endif
+
+    /* Decode whatever remains one character at a time */
+    uint32_t accumulator = 0; /* Holds up to four sextets, or 24 bits */
+    int sextetsLength = 0;
+    for (; i < encodedLength; i++) {
+        unsigned char value = base64Values[(unsigned char)encoded[i]];
+        if (value == 64) /* If whitespace */
+            continue;
+        if (value == 65) /* If padding */
+            break;
+        if (value == 255) /* If not Base64 at all */
+            return false;
+
+        accumulator = (accumulator << 6) | value;
+        sextetsLength++;
+        if (sextetsLength == 4) {
+            if (outputCapacity - o < 3)
+                return false;
+            output[o++] = (unsigned char)(accumulator >> 16);
+            output[o++] = (unsigned char)(accumulator >> 8);
+            output[o++] = (unsigned char)accumulator;
+            accumulator = 0;
+            sextetsLength = 0;
+        }
+    }
+    /* A padded (or truncated) final group of two or three sextets decodes to one or two bytes, respectively */
+    if (sextetsLength == 2 && outputCapacity - o >= 1)
+        output[o++] = (unsigned char)(accumulator >> 4);
+    else if (sextetsLength == 3 && outputCapacity - o >= 2) {
+        output[o++] = (unsigned char)(accumulator >> 10);
+        output[o++] = (unsigned char)(accumulator >> 2);
+    }
+
+    *outputLength = o;
+    return true;
+}
+
+/* Parses a comma-separated list of GIDs directly into 'tiles', writing no more than 'tilesCapacity' of them. Any */
+/* character that isn't a digit is treated as a separator. Returns the number of GIDs found which may exceed the */
+/* capacity if the list is longer than expected. */
+uint32_t DecodeCsvTiles(const char* csv, size_t csvLength, uint32_t* tiles, uint32_t tilesCapacity) {
+    const char* iterator = csv;
+    const char* end = csv + csvLength;
+    uint32_t tilesLength = 0, gid = 0;
+    bool isInGid = false; /* Whether the last character visited was a digit, possibly from a previous block */
+
+#ifdef RAYTMX_SSE2
+    /* Classify 16 characters at a time. The resulting mask lets runs of digits and separators be skipped over */
+    /* whole rather than testing every character, and the digits' values are all computed with one subtraction. */
+    while (end - iterator >= 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)iterator);
+        __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8('0' - 1)),
+            _mm_cmplt_epi8(chunk, _mm_set1_epi8('9' + 1)));
+        uint32_t digitMask = (uint32_t)_mm_movemask_epi8(isDigit);
+        unsigned char digits[16];
+        _mm_storeu_si128((__m128i*)digits, _mm_sub_epi8(chunk, _mm_set1_epi8('0')));
+
+        int position = 0;
+        while (position < 16) {
+            uint32_t remaining = digitMask >> position;
+            if (remaining & 1) { /* If at the start (or continuation) of a run of digits */
+                /* The run ends at the first zero bit. Bit 16 - 'position' is always zero so the run is bounded. */
+                int runLength = CountTrailingZeros(~remaining);
+                for (int j = position; j < position + runLength; j++)
+                    gid = (gid * 10) + digits[j];
+                isInGid = true;
+                position += runLength;
+            } else { /* If at a separator */
+                if (isInGid) {
+                    if (tilesLength < tilesCapacity)
+                        tiles[tilesLength] = gid;
+                    tilesLength++;
+                    gid = 0;
+                    isInGid = false;
+                }
+                if (remaining == 0) /* If there are no more digits in this block */
+                    break;
+                position += CountTrailingZeros(remaining); /* Skip to the next digit */
+            }
+        }
+        iterator += 16;
+    }
+#endif
+
+    /* Parse whatever remains one character at a time */
+    for (; iterator < end; iterator++) {
+        if (*iterator >= '0' && *iterator <= '9') {
+            gid = (gid * 10) + (uint32_t)(*iterator - '0');
+            isInGid = true;
+        } else if (isInGid) {
+            if (tilesLength < tilesCapacity)
+                tiles[tilesLength] = gid;
+            tilesLength++;
+            gid = 0;
+            isInGid = false;
+        }
+    }
+    if (isInGid) { /* If the list ended with a GID rather than a separator */
+        if (tilesLength < tilesCapacity)
+            tiles[tilesLength] = gid;
+        tilesLength++;
+    }
+
+    return tilesLength;
+}
+
+/* Number of zero bits below the lowest set bit. 'value' must not be zero. */
+int CountTrailingZeros(uint32_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(value);
+#else
+    int count = 0;
+    while ((value & 1) == 0) {
+        value >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
 void* MemAllocZero(unsigned int size) {
     void* buffer = MemAlloc(size); /* Reserve 'size' bytes of memory */
     memset(buffer, 0, size); /* Initialize any values to zero, NULL, false, or an equivalent enum value */
@@ -4631,7 +7119,7 @@ void* MemAllocZero(unsigned int size) {
 /* "Get directory for a given filePath" */
 /* raylib's GetDirectoryPath() doesn't work as described so this is used in its place */
 char* GetDirectoryPath2(const char* filePath) {
-    static char directoryPath[260]; /* Max path length on Windows, the bottleneck, is 260 characters */
+    static RAYTMX_THREAD_LOCAL char directoryPath[260]; /* Max path length on Windows, the bottleneck, is 260 characters */
     memset(directoryPath, '\0', 260);
     size_t length = strlen(filePath);
     /* Paths beginning with a Windows drive letter (C:\, D:\, etc.) or beginning with a slash are absolute paths */
@@ -4656,7 +7144,7 @@ char* GetDirectoryPath2(const char* filePath) {
 }
 
 char* JoinPath(const char* prefix, const char* suffix) {
-    static char joinedPath[260]; /* Max path length on Windows, the bottleneck, is 260 characters */
+    static RAYTMX_THREAD_LOCAL char joinedPath[260]; /* Max path length on Windows, the bottleneck, is 260 characters */
     memset(joinedPath, '\0', 260);
     StringCopy(joinedPath, prefix);
     size_t prefixLength = strlen(prefix);
@@ -0,0 +1,86 @@
+// Loads tests/chunk_test.tmx, an infinite map with a wall tile in each of three chunks, and checks that every wall
+// still collides whatever UpdateTMXChunks() has made resident or evicted. Run from the repository's root, as
+// `make test` does. There's no window, so no textures are loaded and no meshes are built
+#include <cstdio>
+
+#define RAYTMX_IMPLEMENTATION
+#include "raytmx.h"
+
+int failures = 0;
+
+void Check(bool condition, const char* what) {
+    if (!condition) {
+        failures++;
+        fprintf(stderr, "chunk_test: %s\n", what);
+    }
+}
+
+Texture2D LoadNoTexture(const char*) { return Texture2D{}; }
+
+TmxTileChunk* FindChunk(TmxTileLayer* tileLayer, int32_t x, int32_t y) {
+    for (uint32_t i = 0; i < tileLayer->chunksLength; i++) {
+        if (tileLayer->chunks[i].x == x && tileLayer->chunks[i].y == y) return &tileLayer->chunks[i];
+    }
+    return nullptr;
+}
+
+// A rectangle over one tile, shrunk so it doesn't touch its neighbours
+Rectangle TileRect(TmxMap* map, int x, int y) {
+    return Rectangle{ x * (float)map->tileWidth + 2, y * (float)map->tileHeight + 2, 4, 4 };
+}
+
+bool IsWall(TmxMap* map, TmxLayer* layer, int x, int y) {
+    return CheckCollisionTMXTileLayersRec(map, layer, 1, TileRect(map, x, y), nullptr);
+}
+
+int main() {
+    SetTraceLogLevel(LOG_NONE); // every texture "fails" to load, which raytmx reports as an error
+    SetLoadTextureTMX(LoadNoTexture);
+    TmxMap* map = LoadTMX("tests/chunk_test.tmx");
+    if (!map || map->layersLength != 1 || map->layers[0].type != LAYER_TYPE_TILE_LAYER) {
+        fprintf(stderr, "chunk_test: failed to load tests/chunk_test.tmx\n");
+        return 1;
+    }
+    TmxLayer* layer = &map->layers[0];
+    TmxTileLayer* tileLayer = &layer->exact.tileLayer;
+    TmxTileChunk* first = FindChunk(tileLayer, 0, 0);
+    TmxTileChunk* second = FindChunk(tileLayer, 64, 0);
+    TmxTileChunk* never = FindChunk(tileLayer, 0, 64);
+    if (!first || !second || !never) {
+        fprintf(stderr, "chunk_test: missing chunks\n");
+        return 1;
+    }
+
+    // Walls are there before anything is resident, from the same decoded tiles the collision checks use
+    Check(!first->isResident && !second->isResident && !never->isResident, "a chunk is resident after loading");
+    Check(GetTMXTileLayerGid(map, tileLayer, 3, 4) == 1, "wrong GID before any chunk is resident");
+    Check(IsWall(map, layer, 3, 4), "no wall before any chunk is resident");
+
+    // Make the first chunk resident, then move away from it with no budget left so it's evicted. Without textures
+    // its meshes are empty, so it's charged for some to be over the budget
+    UpdateTMXChunks(map, Rectangle{ 0, 0, 16 * 16, 16 * 16 });
+    Check(first->isResident, "the first chunk isn't resident while in view");
+    first->residentBytes = 1;
+    map->chunkMemoryUsed += 1;
+    map->chunkMemoryBudget = 0;
+    UpdateTMXChunks(map, Rectangle{ 64 * 16, 0, 16 * 16, 16 * 16 });
+    Check(!first->isResident, "the first chunk wasn't evicted");
+    Check(second->isResident, "the second chunk isn't resident while in view");
+
+    // An evicted chunk, a resident one, and one that was never resident all keep their walls
+    Check(GetTMXTileLayerGid(map, tileLayer, 3, 4) == 1, "wrong GID in an evicted chunk");
+    Check(IsWall(map, layer, 3, 4), "a wall in an evicted chunk doesn't collide");
+    Check(IsWall(map, layer, 70, 2), "a wall in a resident chunk doesn't collide");
+    Check(GetTMXTileLayerGid(map, tileLayer, 5, 70) == 1, "wrong GID in a chunk that was never resident");
+    Check(IsWall(map, layer, 5, 70), "a wall in a chunk that was never resident doesn't collide");
+
+    // Tiles without collision shapes, empty tiles, and places with no chunk at all don't
+    Check(GetTMXTileLayerGid(map, tileLayer, 6, 6) == 2, "wrong GID for a tile without shapes");
+    Check(!IsWall(map, layer, 6, 6), "a tile without shapes collides");
+    Check(!IsWall(map, layer, 4, 4), "an empty tile collides");
+    Check(!IsWall(map, layer, 40, 40), "somewhere without a chunk collides");
+
+    UnloadTMX(map);
+    fprintf(stderr, "chunk_test: %d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,227 @@
+// Runs random Base64 and CSV tile data through raytmx's DecodeBase64() and DecodeCsvTiles() and prints one line per
+// case. `make test` builds this twice, once with RAYTMX_NO_SIMD for the scalar paths, and diffs the two outputs.
+// Every case, malformed ones included, is also checked against a plain reference decoder written the way raytmx
+// decoded tile data before either path existed, so both builds fail on their own
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define RAYTMX_IMPLEMENTATION
+#include "raytmx.h"
+
+const int casesPerKind = 2000;
+uint32_t seed = 12345;
+int failures = 0;
+
+uint32_t Random() {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+int RandomRange(int min, int max) { return min + (int)(Random() % (uint32_t)(max - min + 1)); }
+
+// FNV-1a, so each case prints a short line instead of everything it decoded
+uint32_t Hash(const void* data, size_t length) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) hash = (hash ^ bytes[i]) * 16777619u;
+    return hash;
+}
+
+void Fail(const char* kind, int index, const char* what) {
+    if (failures++ < 10) fprintf(stderr, "%s case %d: %s\n", kind, index, what);
+}
+
+const std::string base64Alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+std::string EncodeBase64(const std::vector<unsigned char>& bytes) {
+    const char* alphabet = base64Alphabet.c_str();
+    std::string out;
+    for (size_t i = 0; i < bytes.size(); i += 3) {
+        uint32_t group = bytes[i] << 16;
+        if (i + 1 < bytes.size()) group |= bytes[i + 1] << 8;
+        if (i + 2 < bytes.size()) group |= bytes[i + 2];
+        out += alphabet[(group >> 18) & 63];
+        out += alphabet[(group >> 12) & 63];
+        out += i + 1 < bytes.size() ? alphabet[(group >> 6) & 63] : '=';
+        out += i + 2 < bytes.size() ? alphabet[group & 63] : '=';
+    }
+    return out;
+}
+
+bool IsWhitespace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+// The old path: the data cut down to its Base64 characters, as it used to be trimmed before going to raylib's
+// DecodeDataBase64(), then decoded a group of four characters at a time. On top of that are DecodeBase64()'s rules:
+// whitespace anywhere is skipped, the first '=' ends the data, anything else outside the alphabet fails, whole groups
+// that don't fit fail, and a final partial group is only written if all of it fits
+bool ReferenceBase64(const std::string& text, size_t capacity, std::vector<unsigned char>& out) {
+    std::string data;
+    for (char c : text) {
+        if (c == '=') break;
+        if (IsWhitespace(c)) continue;
+        if (base64Alphabet.find(c) == std::string::npos) return false;
+        data += c;
+    }
+
+    out.clear();
+    size_t i = 0;
+    for (; i + 4 <= data.size(); i += 4) {
+        uint32_t group = 0;
+        for (size_t j = 0; j < 4; j++) group = (group << 6) | (uint32_t)base64Alphabet.find(data[i + j]);
+        out.push_back((unsigned char)(group >> 16));
+        out.push_back((unsigned char)(group >> 8));
+        out.push_back((unsigned char)group);
+    }
+    if (out.size() > capacity) return false;
+
+    // Two or three characters left over make one or two bytes, a single one makes nothing
+    size_t left = data.size() - i;
+    if (left >= 2 && out.size() + left - 1 <= capacity) {
+        uint32_t group = 0;
+        for (size_t j = 0; j < 4; j++) {
+            group = (group << 6) | (j < left ? (uint32_t)base64Alphabet.find(data[i + j]) : 0);
+        }
+        out.push_back((unsigned char)(group >> 16));
+        if (left == 3) out.push_back((unsigned char)(group >> 8));
+    }
+    return true;
+}
+
+// The old path: the text split into one GID's worth of characters at a time, each then read as a number. Any
+// non-digit separates GIDs, and GIDs too big for 32 bits wrap around as they do in DecodeCsvTiles()
+std::vector<uint32_t> ReferenceCsv(const std::string& text) {
+    std::vector<uint32_t> gids;
+    std::string digits;
+    for (size_t i = 0; i <= text.size(); i++) {
+        if (i < text.size() && text[i] >= '0' && text[i] <= '9') {
+            digits += text[i];
+        } else if (!digits.empty()) {
+            uint32_t gid = 0;
+            for (char d : digits) gid = gid * 10 + (uint32_t)(d - '0');
+            gids.push_back(gid);
+            digits.clear();
+        }
+    }
+    return gids;
+}
+
+// Whitespace TMX files put around and inside their data
+void InsertWhitespace(std::string& text) {
+    static const char whitespace[] = " \t\r\n";
+    int count = RandomRange(1, 6);
+    for (int i = 0; i < count; i++) {
+        text.insert(text.begin() + RandomRange(0, (int)text.size()), whitespace[Random() % 4]);
+    }
+}
+
+void TestBase64(int index) {
+    std::vector<unsigned char> bytes(RandomRange(0, 200));
+    for (auto& b : bytes) b = (unsigned char)Random();
+    std::string text = EncodeBase64(bytes);
+
+    // Most cases get mangled in some way, only the clean ones are also checked against the original bytes
+    int kind = RandomRange(0, 6);
+    bool wellFormed = kind <= 2;
+    if (kind == 1) {
+        while (!text.empty() && text.back() == '=') text.pop_back(); // no padding
+    } else if (kind == 2) {
+        InsertWhitespace(text);
+    } else if (kind == 3) {
+        text.resize(RandomRange(0, (int)text.size())); // cut off anywhere, so groups end at odd lengths
+    } else if (kind == 4 && !text.empty()) {
+        static const char invalid[] = {'!', '-', '_', '.', '\0', (char)0x80, (char)0xFF, '~'};
+        text[RandomRange(0, (int)text.size() - 1)] = invalid[Random() % sizeof(invalid)];
+    } else if (kind == 5) {
+        text += "==AAAA"; // anything after padding is ignored
+    } else if (kind == 6) {
+        text.insert(RandomRange(0, (int)text.size()), "="); // padding in the middle ends the data early
+    }
+
+    // Sometimes too little room, which has to fail the same way on both paths
+    size_t capacity = bytes.size() + 16;
+    if (Random() % 4 == 0) capacity = RandomRange(0, (int)bytes.size() + 2);
+    std::vector<unsigned char> output(capacity + 1);
+    size_t outputLength = 0;
+    bool decoded = DecodeBase64(text.data(), text.size(), output.data(), capacity, &outputLength);
+
+    if (decoded) printf("base64 %d: ok %zu %08x\n", index, outputLength, Hash(output.data(), outputLength));
+    else printf("base64 %d: failed\n", index);
+
+    std::vector<unsigned char> reference;
+    bool referenceDecoded = ReferenceBase64(text, capacity, reference);
+    if (decoded != referenceDecoded) {
+        Fail("base64", index, decoded ? "decoded data the reference rejects" : "failed where the reference decodes");
+    } else if (decoded && (outputLength != reference.size() ||
+                           !std::equal(reference.begin(), reference.end(), output.begin()))) {
+        Fail("base64", index, "decoded data doesn't match the reference");
+    }
+
+    if (wellFormed && capacity >= bytes.size()) {
+        if (!decoded) Fail("base64", index, "well-formed data failed to decode");
+        else if (outputLength != bytes.size() || !std::equal(bytes.begin(), bytes.end(), output.begin()))
+            Fail("base64", index, "decoded data doesn't match what was encoded");
+    }
+}
+
+void TestCsv(int index) {
+    std::vector<uint32_t> gids(RandomRange(0, 300));
+    for (auto& gid : gids) {
+        int size = RandomRange(0, 3);
+        gid = size == 0 ? 0 : size == 1 ? Random() % 100 : size == 2 ? Random() % 100000 : Random(); // flip flags too
+    }
+
+    // Tiled writes "1,2,3," with a newline after every row, the rest are things a hand-edited file might have
+    static const char* separators[] = {",", ",\n", ", ", " , ", ",\r\n", ";"};
+    const char* separator = separators[RandomRange(0, 5)];
+    std::string text = Random() % 2 ? "\n" : "";
+    for (size_t i = 0; i < gids.size(); i++) {
+        text += std::to_string(gids[i]);
+        if (i + 1 < gids.size() || Random() % 2) text += separator;
+    }
+    if (Random() % 2) text += "\n";
+
+    int kind = RandomRange(0, 3);
+    bool wellFormed = kind == 0;
+    if (kind == 1) {
+        InsertWhitespace(text); // can split a GID in two, so this is only compared between the paths
+    } else if (kind == 2 && !text.empty()) {
+        static const char junk[] = {'x', '-', '#', (char)0x80, (char)0xFF, '\0'};
+        text[RandomRange(0, (int)text.size() - 1)] = junk[Random() % sizeof(junk)];
+    } else if (kind == 3) {
+        text += std::string(RandomRange(1, 20), '9'); // overflows a GID
+    }
+
+    uint32_t capacity = (uint32_t)gids.size();
+    if (Random() % 4 == 0) capacity = RandomRange(0, (int)gids.size());
+    std::vector<uint32_t> tiles(capacity + 1);
+    uint32_t found = DecodeCsvTiles(text.data(), text.size(), tiles.data(), capacity);
+    uint32_t written = found < capacity ? found : capacity;
+    printf("csv %d: %u %08x\n", index, found, Hash(tiles.data(), written * sizeof(uint32_t)));
+
+    std::vector<uint32_t> reference = ReferenceCsv(text);
+    if (found != reference.size()) Fail("csv", index, "found a different number of GIDs than the reference");
+    else if (!std::equal(tiles.begin(), tiles.begin() + written, reference.begin()))
+        Fail("csv", index, "GIDs don't match the reference");
+
+    if (wellFormed) {
+        if (found != gids.size()) Fail("csv", index, "wrong number of GIDs");
+        else if (!std::equal(tiles.begin(), tiles.begin() + written, gids.begin()))
+            Fail("csv", index, "GIDs don't match what was written");
+    }
+}
+
+int main() {
+    for (int i = 0; i < casesPerKind; i++) TestBase64(i);
+    for (int i = 0; i < casesPerKind; i++) TestCsv(i);
+#ifdef RAYTMX_SSE2
+    fprintf(stderr, "decode_test (SSE2): %d failures\n", failures);
+#else
+    fprintf(stderr, "decode_test (scalar): %d failures\n", failures);
+#endif
+    return failures == 0 ? 0 : 1;
+}